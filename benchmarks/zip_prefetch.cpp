@@ -0,0 +1,115 @@
+/**
+** \file zip_prefetch.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 16:20
+** \date Last update: 2026-10-18 16:20
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "hex/containers/sparse_array.hpp"
+#include "hex/iterators/zip.hpp"
+
+/*
+** Walks joins of large sparse arrays with and without zip::prefetch, and prints the time per matching entity.
+**
+** Layouts:
+**  - sparse: every container sets each index independently, so most indices are holes in at least one container.
+**  - random-id: entities have random ids over a large range, and most of them have every component.
+**
+** Usage: Hex_zip_prefetch_bench [slots] [repetitions]
+*/
+
+struct position { double x, y, z, pad[5]; };
+struct velocity { double vx, vy, vz, pad[5]; };
+struct mass { double m, pad[7]; };
+
+struct layout {
+    char const *name;
+    hex::containers::sparse_array<position> positions;
+    hex::containers::sparse_array<velocity> velocities;
+    hex::containers::sparse_array<mass> masses;
+};
+
+static void fill_sparse(layout &l, std::size_t slots, std::mt19937_64 &rng) {
+    std::bernoulli_distribution set{0.3};
+
+    for (std::size_t i = 0; i < slots; ++i) {
+        if (set(rng)) l.positions.insert_at(i, position{1., 2., 3., {}});
+        if (set(rng)) l.velocities.insert_at(i, velocity{.5, .5, .5, {}});
+        if (set(rng)) l.masses.insert_at(i, mass{2., {}});
+    }
+}
+
+static void fill_random_ids(layout &l, std::size_t slots, std::mt19937_64 &rng) {
+    std::uniform_int_distribution<std::size_t> id{0, slots - 1};
+    std::bernoulli_distribution moving{0.9};
+
+    for (std::size_t n = 0; n < slots / 16; ++n) {
+        auto i = id(rng);
+
+        l.positions.insert_at(i, position{1., 2., 3., {}});
+        l.masses.insert_at(i, mass{2., {}});
+        if (moving(rng)) l.velocities.insert_at(i, velocity{.5, .5, .5, {}});
+    }
+
+    l.positions.resize(slots);
+    l.velocities.resize(slots);
+    l.masses.resize(slots);
+}
+
+static std::size_t matches = 0;
+
+template <class Zip>
+static double run(Zip const &z, int repetitions) {
+    double best = 1e300;
+
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        double sum = 0.;
+        std::size_t n = 0;
+
+        for (auto [p, v, m] : z) {
+            sum += (p.x * v.vx + p.y * v.vy + p.z * v.vz) * m.m;
+            ++n;
+        }
+
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        if (sum < 0.) std::puts("");
+        matches = n;
+        best = std::min(best, elapsed / static_cast<double>(n ? n : 1));
+    }
+
+    return best;
+}
+
+int main(int argc, char **argv) {
+    std::size_t slots = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{1} << 22;
+    int repetitions = argc > 2 ? std::atoi(argv[2]) : 5;
+    std::mt19937_64 rng{42};
+    layout layouts[2] = {{"sparse", {}, {}, {}}, {"random-id", {}, {}, {}}};
+
+    fill_sparse(layouts[0], slots, rng);
+    fill_random_ids(layouts[1], slots, rng);
+
+    std::printf("%-10s %10s %10s %12s\n", "layout", "matches", "distance", "ns/match");
+
+    for (auto &l : layouts) {
+        hex::iterators::zip z{l.positions, l.velocities, l.masses};
+
+        for (std::size_t distance : {0, 8, 32, 64, 128, 256}) {
+            double ns = run(z.prefetch(distance), repetitions);
+
+            std::printf("%-10s %10zu %10zu %12.2f\n", l.name, matches, distance, ns);
+        }
+    }
+
+    return 0;
+}
@@ -12,14 +12,17 @@
 #include <any> // std::any, std::any_cast, std::make_any
 #include <cstddef> // std::size_t
 #include <functional> // std::function
+#include <memory> // std::unique_ptr, std::make_unique
 #include <typeinfo> // typeid
 #include <typeindex> // std::type_index
 #include <type_traits> // std::decay_t
 #include <unordered_map> // std::unordered_map
 #include <utility> // std::as_const, std::forward, std::function
+#include <vector> // std::vector, std::erase
 
 #include "hex/containers/sparse_array.hpp"
 #include "hex/exceptions/already_registered.hpp"
+#include "hex/query/forward.hpp"
 
 namespace hex {
     /**
@@ -31,6 +34,9 @@ namespace hex {
     **
     ** Internally, every components collections are stored in a std::unordered_map, through the use of an std::any to provide type erasure. The components are
     ** any_cast back to their proper type upon retrieval.
+    **
+    ** Persistent queries (query::persistent) can be registered too. The registry then notifies them each time one of
+    ** their components is inserted, emplaced or removed through it, so they stay up to date without rescanning.
     */
     class components_registry {
         public:
@@ -208,6 +214,7 @@ namespace hex {
                 auto & cont = get<Component>();
 
                 cont.insert_at(idx, std::forward<Component>(c));
+                _notify(typeid(std::decay_t<Component>), idx);
 
                 return cont.at(idx).value();
             }
@@ -239,6 +246,7 @@ namespace hex {
                 auto &cont = get<Component>();
 
                 cont.emplace_at(idx, std::forward<Params>(ps)...);
+                _notify(typeid(std::decay_t<Component>), idx);
 
                 return cont.at(idx).value();
             }
@@ -263,8 +271,10 @@ namespace hex {
             void remove_at(std::size_t index) {
                 auto &cont = get<Component>();
 
-                if (cont.size() > index)
+                if (cont.size() > index) {
                     cont.erase_at(index);
+                    _notify(typeid(std::decay_t<Component>), index);
+                }
             }
 
             /**
@@ -280,10 +290,82 @@ namespace hex {
                 }
             }
             /** @} */
+
+            /**
+            ** \name Persistent queries
+            **
+            ** \note hex/query/persistent.hpp must be included to register queries.
+            */
+            /** @{ */
+            /**
+            ** \brief Register a persistent query, or get the one already registered with the same parameters.
+            **
+            ** The query is filled upon registration, then kept up to date by the registry, which owns it.
+            **
+            ** \tparam Ts Included, read-only, and excluded components, as for query::view.
+            **
+            ** \throw std::out_of_range is thrown if an included component wasn't registered beforehand.
+            */
+            template <typename... Ts>
+            query::persistent<Ts...> &register_query() {
+                std::type_index key = typeid(query::persistent<Ts...>);
+
+                if (auto it = _queries.find(key); it != _queries.end())
+                    return static_cast<query::persistent<Ts...> &>(*it->second);
+
+                auto q = std::make_unique<query::persistent<Ts...>>();
+
+                q->rebuild(*this);
+                for (auto const &type : q->watched())
+                    _listeners[type].push_back(q.get());
+
+                return static_cast<query::persistent<Ts...> &>(*_queries.emplace(key, std::move(q)).first->second);
+            }
+
+            /**
+            ** \brief Unregister a persistent query, destroying it.
+            **
+            ** \return False if no such query was registered.
+            */
+            template <typename... Ts>
+            bool unregister_query() {
+                auto it = _queries.find(typeid(query::persistent<Ts...>));
+
+                if (it == _queries.end())
+                    return false;
+
+                for (auto &[type, listeners] : _listeners)
+                    std::erase(listeners, it->second.get());
+
+                _queries.erase(it);
+                return true;
+            }
+
+            /**
+            ** \brief Rebuild every persistent query, after containers were modified without going through the registry.
+            */
+            void refresh_queries() {
+                for (auto &[type, q] : _queries)
+                    q->rebuild(*this);
+            }
+            /** @} */
+        private:
+            void _notify(std::type_index type, std::size_t idx) {
+                if (_listeners.empty())
+                    return;
+
+                if (auto it = _listeners.find(type); it != _listeners.end())
+                    for (auto *l : it->second)
+                        l->update(*this, idx);
+            }
+
         private:
             std::unordered_map<std::type_index, std::any> _registry;
 
             std::vector<std::function<void(components_registry &, std::size_t)>> _erasers;
+
+            std::unordered_map<std::type_index, std::unique_ptr<query::listener>> _queries;
+            std::unordered_map<std::type_index, std::vector<query::listener *>> _listeners; /**< Queries to notify, by component type. */
     };
 }
 
@@ -0,0 +1,171 @@
+/**
+** \file group.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 18:05
+** \date Last update: 2026-10-18 18:05
+*/
+
+#ifndef containers_group_hpp__
+#define containers_group_hpp__
+
+#include <array> // std::array
+#include <cstddef> // std::ptrdiff_t, std::size_t
+#include <iterator> // std::forward_iterator_tag
+#include <span> // std::span
+#include <tuple> // std::tuple, std::tuple_cat, std::apply
+#include <utility> // std::index_sequence_for
+
+namespace hex::containers {
+    /**
+    ** \brief Keep the elements shared by several packed arrays at the front of each of them, in the same order.
+    **
+    ** A group moves the elements whose index is present in every array to positions [0, size()) of each array, with the
+    ** same index at the same position everywhere. Walking the group is then a linear walk of aligned prefixes, with no
+    ** lookup nor skipping: each array's prefix is a plain span.
+    **
+    ** The arrays are regrouped by refresh, when any of them changed since the last grouping. It is called upon
+    ** construction and by begin, each, and spans. Regrouping is linear in the size of the smallest array.
+    **
+    ** \warning A group owns the order of its arrays: an array must not belong to two groups, nor be sorted, nor be
+    ** iterated with a merge_join, while a group is in use.
+    **
+    ** \tparam Arrays Types of the packed arrays.
+    */
+    template <class... Arrays>
+    class group {
+        static_assert(sizeof...(Arrays) != 0, "Cannot group no arrays.");
+
+        public:
+            using value_type = std::tuple<typename Arrays::reference...>;
+
+            class iterator {
+                public:
+                    using value_type = group::value_type;
+                    using reference = value_type;
+                    using pointer = void;
+                    using difference_type = std::ptrdiff_t;
+                    using iterator_category = std::forward_iterator_tag;
+
+                    iterator() = default;
+                    iterator(group const *g, std::size_t pos) : _group(g), _pos(pos) {}
+
+                    iterator &operator++() { ++_pos; return *this; }
+                    iterator operator++(int) { auto r = *this; ++_pos; return r; }
+
+                    reference operator*() const { return _group->_at(_pos, _idx_seq); }
+
+                    /**
+                    ** \brief Index of the current element.
+                    */
+                    [[nodiscard]] std::size_t index() const { return std::get<0>(_group->_arrays)->ids()[_pos]; }
+
+                    friend bool operator==(iterator const &lhs, iterator const &rhs) noexcept { return lhs._pos == rhs._pos; }
+
+                private:
+                    group const *_group = nullptr;
+                    std::size_t _pos = 0;
+            };
+
+        public:
+            explicit group(Arrays &... arrays) : _arrays{&arrays...} { refresh(); }
+
+            /**
+            ** \brief Regroup the arrays if any of them changed since the last grouping.
+            */
+            void refresh() {
+                if (!_grouped || _versions != _current_versions(_idx_seq))
+                    _regroup(_idx_seq);
+            }
+
+            /**
+            ** \brief Number of indices present in every array, as of the last grouping.
+            */
+            [[nodiscard]] std::size_t size() const noexcept { return _size; }
+            [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+            iterator begin() { refresh(); return iterator{this, 0}; }
+            iterator end() const noexcept { return iterator{this, _size}; }
+
+            /**
+            ** \brief Call f with the index and elements of every grouped entity.
+            */
+            template <class F>
+            void each(F &&f) {
+                refresh();
+
+                auto const ids = std::get<0>(_arrays)->ids();
+
+                for (std::size_t pos = 0; pos < _size; ++pos)
+                    std::apply(f, std::tuple_cat(std::tuple<std::size_t>{ids[pos]}, _at(pos, _idx_seq)));
+            }
+
+            /**
+            ** \brief Spans over the grouped prefix of each array, e.g. for kernels compilers can vectorize.
+            */
+            [[nodiscard]] auto spans() {
+                refresh();
+                return std::apply([this](auto *... a) { return std::tuple{a->values().first(_size)...}; }, _arrays);
+            }
+
+        private:
+            template <std::size_t... Idx>
+            std::array<std::size_t, sizeof...(Arrays)> _current_versions(std::index_sequence<Idx...>) const noexcept {
+                return {std::get<Idx>(_arrays)->version()...};
+            }
+
+            template <std::size_t... Idx>
+            value_type _at(std::size_t pos, std::index_sequence<Idx...>) const {
+                return value_type{std::get<Idx>(_arrays)->values()[pos]...};
+            }
+
+            template <std::size_t... Idx>
+            void _regroup(std::index_sequence<Idx...> seq) {
+                std::size_t smallest = 0;
+                std::array<std::size_t, sizeof...(Arrays)> sizes{std::get<Idx>(_arrays)->size()...};
+
+                for (std::size_t i = 1; i < sizes.size(); ++i)
+                    if (sizes[i] < sizes[smallest])
+                        smallest = i;
+
+                ((Idx == smallest && (_regroup_from<Idx>(), true)) || ...);
+                _versions = _current_versions(seq);
+                _grouped = true;
+            }
+
+            /*
+            ** Partition the arrays, walking the Ith one: its positions below _size hold the grouped indices, and the
+            ** positions from _size up to the current one hold those that are missing from another array.
+            */
+            template <std::size_t I>
+            void _regroup_from() {
+                auto *driver = std::get<I>(_arrays);
+
+                _size = 0;
+                for (std::size_t pos = 0; pos < driver->size(); ++pos) {
+                    std::size_t id = driver->ids()[pos];
+
+                    if (std::apply([id](auto *... a) { return (a->contains(id) && ...); }, _arrays)) {
+                        std::apply([id, this](auto *... a) { (a->move_to(id, _size), ...); }, _arrays);
+                        ++_size;
+                    }
+                }
+            }
+
+        private:
+            std::tuple<Arrays *...> _arrays;
+            std::array<std::size_t, sizeof...(Arrays)> _versions{};
+            std::size_t _size = 0;
+            bool _grouped = false;
+
+            static constexpr std::index_sequence_for<Arrays...> _idx_seq{};
+    };
+
+    /**
+    ** \related group
+    */
+    template <class... Arrays>
+    group(Arrays &...) -> group<Arrays...>;
+}
+
+#endif /* end of include guard: containers_group_hpp__ */
@@ -0,0 +1,297 @@
+/**
+** \file packed_array.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 17:05
+** \date Last update: 2026-10-18 18:05
+*/
+
+#ifndef PACKED_ARRAY_HPP_
+#define PACKED_ARRAY_HPP_
+
+#include <algorithm> // std::lower_bound, std::sort
+#include <cstddef> // std::size_t
+#include <iterator> // std::distance
+#include <memory> // std::allocator
+#include <numeric> // std::iota
+#include <span> // std::span
+#include <stdexcept> // std::out_of_range
+#include <utility> // std::as_const, std::forward, std::move, std::swap
+#include <vector> // std::vector
+
+namespace hex::containers {
+    /**
+    ** \brief Packed array.
+    **
+    ** This class stores its elements contiguously, along with the list of their indices, and the position of each index
+    ** for constant time lookup. Walking it only touches existing elements.
+    **
+    ** Elements are kept in index order, until sort or move_to reorder them. In index order, two packed arrays can be
+    ** joined by merging their index lists, and inserting in ascending index order appends. Inserting anywhere else, or
+    ** erasing, moves the following elements. Once reordered, insertions append, until sort() restores the index order.
+    **
+    ** \see iterators::merge_join, containers::group
+    */
+    template <typename T, typename Allocator = std::allocator<T>>
+    class packed_array {
+        using base_t = std::vector<T, Allocator>;
+
+        public:
+            using value_type = T;
+            using allocator_type = Allocator;
+            using size_type = std::size_t;
+            using reference = T &;
+            using const_reference = T const &;
+            using iterator = typename base_t::iterator;
+            using const_iterator = typename base_t::const_iterator;
+
+        public:
+            packed_array() = default;
+            explicit packed_array(Allocator const &alloc) : _values(alloc) {}
+
+            /**
+            ** \name Element access
+            */
+            /** @{ */
+            /**
+            ** \brief Indices of the elements, sorted if index_ordered().
+            */
+            [[nodiscard]] std::span<size_type const> ids() const noexcept { return _ids; }
+
+            /**
+            ** \brief Elements, in the same order as ids().
+            */
+            [[nodiscard]] std::span<T> values() noexcept { return _values; }
+            [[nodiscard]] std::span<T const> values() const noexcept { return _values; }
+
+            [[nodiscard]] bool contains(size_type pos) const noexcept { return _find(pos) != _ids.size(); }
+
+            /**
+            ** \brief Get a pointer to the element at pos, or nullptr if there is none.
+            */
+            [[nodiscard]] T *find(size_type pos) noexcept { return _ptr(_find(pos)); }
+            [[nodiscard]] T const *find(size_type pos) const noexcept { return const_cast<packed_array *>(this)->find(pos); }
+
+            /**
+            ** \throw std::out_of_range is thrown if there is no element at pos.
+            */
+            [[nodiscard]] reference at(size_type pos) {
+                if (T *p = find(pos))
+                    return *p;
+
+                throw std::out_of_range("at error: no element at this index in packed_array.");
+            }
+
+            [[nodiscard]] const_reference at(size_type pos) const { return const_cast<packed_array *>(this)->at(pos); }
+
+            /**
+            ** \brief Position of the element at pos in ids() and values(), or size() if there is none.
+            */
+            [[nodiscard]] size_type position(size_type pos) const noexcept { return _find(pos); }
+
+            /**
+            ** \brief Check whether the elements are in index order, as merge_join requires.
+            */
+            [[nodiscard]] bool index_ordered() const noexcept { return _ordered; }
+
+            /**
+            ** \brief Counter bumped by every change of the set of elements or of their order.
+            */
+            [[nodiscard]] std::size_t version() const noexcept { return _version; }
+            /** @} */
+
+            /**
+            ** \name Iterators
+            */
+            /** @{ */
+            [[nodiscard]] iterator begin() noexcept { return _values.begin(); }
+            [[nodiscard]] const_iterator begin() const noexcept { return _values.begin(); }
+            [[nodiscard]] iterator end() noexcept { return _values.end(); }
+            [[nodiscard]] const_iterator end() const noexcept { return _values.end(); }
+            /** @} */
+
+            /**
+            ** \name Capacity
+            */
+            /** @{ */
+            [[nodiscard]] bool empty() const noexcept { return _ids.empty(); }
+            [[nodiscard]] size_type size() const noexcept { return _ids.size(); }
+
+            void reserve(size_type n) {
+                _ids.reserve(n);
+                _values.reserve(n);
+            }
+            /** @} */
+
+            /**
+            ** \name Modifier
+            */
+            /** @{ */
+            void clear() noexcept {
+                _ids.clear();
+                _values.clear();
+                _sparse.clear();
+                _ordered = true;
+                ++_version;
+            }
+
+            template <typename U = T>
+            reference insert_at(size_type pos, U &&value) {
+                return emplace_at(pos, std::forward<U>(value));
+            }
+
+            /**
+            ** \brief Construct an element at pos, replacing any existing one.
+            */
+            template <class... Args>
+            reference emplace_at(size_type pos, Args &&... args) {
+                if (size_type off = _find(pos); off != _ids.size()) {
+                    _values[off] = T(std::forward<Args>(args)...);
+                    return _values[off];
+                }
+
+                auto it = _ordered ? std::lower_bound(_ids.begin(), _ids.end(), pos) : _ids.end();
+                size_type off = std::distance(_ids.begin(), it);
+
+                if (pos >= _sparse.size())
+                    _sparse.resize(pos + 1, npos);
+
+                auto vit = _values.emplace(_values.begin() + off, std::forward<Args>(args)...);
+
+                try {
+                    _ids.insert(it, pos);
+                } catch (...) {
+                    _values.erase(vit);
+                    throw;
+                }
+
+                _reindex(off);
+                ++_version;
+                return *vit;
+            }
+
+            /**
+            ** \brief Erase the element at pos, if any. The order of the remaining elements is kept.
+            */
+            void erase_at(size_type pos) {
+                size_type off = _find(pos);
+
+                if (off == _ids.size())
+                    return;
+
+                _ids.erase(_ids.begin() + off);
+                _values.erase(_values.begin() + off);
+                _sparse[pos] = npos;
+                _reindex(off);
+                ++_version;
+            }
+
+            /**
+            ** \brief Swap the element at pos with the one at position to, in ids() and values().
+            **
+            ** \pre There must be an element at pos, and to must be below size().
+            */
+            void move_to(size_type pos, size_type to) {
+                size_type from = _find(pos);
+
+                if (from == to)
+                    return;
+
+                using std::swap;
+                swap(_values[from], _values[to]);
+                swap(_ids[from], _ids[to]);
+
+                _sparse[_ids[from]] = from;
+                _sparse[_ids[to]] = to;
+                _ordered = false;
+                ++_version;
+            }
+
+            /**
+            ** \brief Reorder the elements so that comp(values()[i], values()[i + 1]) never holds backward.
+            **
+            ** For instance, sorting sprites by texture or position makes a later walk over them batch-friendly.
+            */
+            template <class Compare>
+            void sort(Compare comp) {
+                _permute([&](size_type lhs, size_type rhs) { return comp(std::as_const(_values[lhs]), std::as_const(_values[rhs])); });
+                _ordered = false;
+            }
+
+            /**
+            ** \brief Restore the index order.
+            */
+            void sort() {
+                if (_ordered)
+                    return;
+
+                _permute([&](size_type lhs, size_type rhs) { return _ids[lhs] < _ids[rhs]; });
+                _ordered = true;
+            }
+
+            void swap(packed_array &oth) noexcept {
+                using std::swap;
+
+                _ids.swap(oth._ids);
+                _values.swap(oth._values);
+                _sparse.swap(oth._sparse);
+                swap(_ordered, oth._ordered);
+                swap(_version, oth._version);
+            }
+            /** @} */
+
+        private:
+            static constexpr size_type npos = static_cast<size_type>(-1);
+
+            size_type _find(size_type pos) const noexcept {
+                return pos < _sparse.size() && _sparse[pos] != npos ? _sparse[pos] : _ids.size();
+            }
+
+            T *_ptr(size_type off) noexcept { return off == _ids.size() ? nullptr : &_values[off]; }
+
+            void _reindex(size_type from) noexcept {
+                for (size_type i = from; i < _ids.size(); ++i)
+                    _sparse[_ids[i]] = i;
+            }
+
+            /*
+            ** Sort positions with comp, then move ids and values into that order.
+            */
+            template <class Compare>
+            void _permute(Compare comp) {
+                std::vector<size_type> order(_ids.size());
+                std::iota(order.begin(), order.end(), size_type{0});
+                std::sort(order.begin(), order.end(), comp);
+
+                std::vector<size_type> ids;
+                base_t values(_values.get_allocator());
+
+                ids.reserve(order.size());
+                values.reserve(order.size());
+
+                for (size_type i : order) {
+                    ids.push_back(_ids[i]);
+                    values.push_back(std::move(_values[i]));
+                }
+
+                _ids = std::move(ids);
+                _values = std::move(values);
+                _reindex(0);
+                ++_version;
+            }
+
+        private:
+            std::vector<size_type> _ids; /**< Indices, parallel to _values. */
+            base_t _values;
+            std::vector<size_type> _sparse; /**< Position of each index in _ids, or npos. */
+            bool _ordered = true; /**< Whether _ids is sorted. */
+            std::size_t _version = 0;
+    };
+
+    template <typename T, class Allocator>
+    void swap(packed_array<T, Allocator> &lhs, packed_array<T, Allocator> &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
+
+#endif /* end of include guard: PACKED_ARRAY_HPP_ */
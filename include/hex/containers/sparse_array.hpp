@@ -3,13 +3,15 @@
 **
 ** \author Phantomas <phantomas@phantomas.xyz>
 ** \date Created on: 2021-10-29 12:28
-** \date Last update: 2024-07-20 16:24
+** \date Last update: 2026-10-18 19:30
 */
 
 #ifndef SPARSE_ARRAY_HPP_
 #define SPARSE_ARRAY_HPP_
 
-#include <algorithm> // std::transform
+#include <algorithm> // std::min, std::transform
+#include <bit> // std::countr_zero, std::popcount
+#include <cstdint> // std::uint64_t
 #include <initializer_list> // std::initializer_list
 #include <iterator> // std::iterator_traits
 #include <memory> // std::allocator
@@ -27,6 +29,11 @@ namespace hex::containers {
     **
     ** This class is an array of optional values.
     **
+    ** Alongside the values, it keeps a presence bitmap, one bit per slot, so that iterators::zip can skip 64 empty slots
+    ** at once. insert_at, emplace_at and erase_at keep it exact. operator[] and at, which may be used to write a value,
+    ** mark their slot as possibly present. Writing a value into an empty slot through an iterator or data() is not
+    ** tracked: zips would skip that slot until it is set again by one of the functions above.
+    **
     ** \see SparseArrayDeduc
     */
     template <typename T, typename Allocator = std::allocator<std::optional<T>>>
@@ -70,6 +77,7 @@ namespace hex::containers {
                 >, bool> = true, typename = meta::require_input_iterator<InputIt>>
             sparse_array(InputIt first, InputIt last, Allocator const &alloc = Allocator()) : base_t(last - first, alloc) {
                 std::transform(first, last, begin(), [](auto const &t){ return std::make_optional<T>(t); });
+                _rebuild_presence();
             }
 
             template <class InputIt, typename = std::enable_if_t<
@@ -94,17 +102,21 @@ namespace hex::containers {
                 >, bool> = true>
             sparse_array(std::initializer_list<U> init, Allocator const &alloc = Allocator()) : base_t(init.size(), alloc) {
                 std::transform(init.begin(), init.end(), begin(), [](auto const &t){ return std::make_optional<T>(t); });
+                _rebuild_presence();
             }
 
             //sparse_array(std::initializer_list<value_type> init, Allocator const &alloc = Allocator());
 
             //~sparse_array();
 
-            using base_t::operator=;
             //sparse_array &operator=(sparse_array const &);
             //sparse_array &operator=(sparse_array &&) noexcept;
 
-            sparse_array &operator=(std::initializer_list<value_type> init) { return reinterpret_cast<sparse_array &>(base_t::operator=(init)); }
+            sparse_array &operator=(std::initializer_list<value_type> init) {
+                base_t::operator=(init);
+                _rebuild_presence();
+                return *this;
+            }
 
             template <typename U = T, std::enable_if_t<!
                 std::disjunction_v<
@@ -117,8 +129,10 @@ namespace hex::containers {
                 return *this;
             }
 
-            using base_t::assign;
-            //void assign(size_t count, T const &value);
+            void assign(size_type count, value_type const &value) {
+                base_t::assign(count, value);
+                _rebuild_presence();
+            }
 
             template <typename U = T, std::enable_if_t<!
                 std::disjunction_v<
@@ -128,6 +142,7 @@ namespace hex::containers {
                 >, bool> = true>
                 void assign(size_t count, U const &v) {
                      base_t::assign(count, std::make_optional<std::decay_t<U>>(v));
+                     _rebuild_presence();
                 }
 
             template <class InputIt, std::enable_if_t<!
@@ -142,14 +157,30 @@ namespace hex::containers {
                 base_t::resize(dist);
 
                 std::transform(first, last, base_t::begin(), [](auto &t){ return std::make_optional<T>(t); });
+                _rebuild_presence();
             }
 
             template <class InputIt, typename = std::enable_if_t<
                 meta::is_optional_v<typename std::iterator_traits<InputIt>::value_type>>,
                      typename = meta::require_input_iterator<InputIt>>
-            void assign(InputIt first, InputIt last) { base_t::assign(first, last); }
+            void assign(InputIt first, InputIt last) {
+                base_t::assign(first, last);
+                _rebuild_presence();
+            }
 
-            void assign(std::initializer_list<value_type> init) { base_t::assign(init); }
+            template <class InputIt, std::enable_if_t<
+                !meta::is_optional_v<typename std::iterator_traits<InputIt>::value_type> &&
+                std::is_constructible_v<value_type, typename std::iterator_traits<InputIt>::value_type>, int
+            > = 0, typename = meta::require_input_iterator<InputIt>>
+            void assign(InputIt first, InputIt last) {
+                base_t::assign(first, last);
+                _rebuild_presence();
+            }
+
+            void assign(std::initializer_list<value_type> init) {
+                base_t::assign(init);
+                _rebuild_presence();
+            }
 
             template <typename U = T, std::enable_if_t<!
                 std::disjunction_v<
@@ -161,6 +192,7 @@ namespace hex::containers {
                 base_t::resize(init.size());
 
                 std::transform(init.begin(), init.end(), begin(), [](auto const &t){ return std::make_optional<T>(t); });
+                _rebuild_presence();
             }
 
             using base_t::get_allocator;
@@ -170,15 +202,31 @@ namespace hex::containers {
             ** \name Element access
             */
             /** @{ */
-            using base_t::at;
-            //[[nodiscard]] reference at(size_type pos);
-            //[[nodiscard]] const_reference at(size_type pos) const;
+            /**
+            ** \brief Access the slot at pos, with bounds checking.
+            **
+            ** The slot is marked as possibly present, since a value may be written through the returned reference.
+            */
+            [[nodiscard]] reference at(size_type pos) {
+                reference slot = base_t::at(pos);
+
+                _mark(pos, true);
+                return slot;
+            }
+
+            [[nodiscard]] const_reference at(size_type pos) const { return base_t::at(pos); }
 
             //using base_t::operator[];
+            /**
+            ** \brief Access the slot at pos, growing the array if needed.
+            **
+            ** The slot is marked as possibly present, since a value may be written through the returned reference.
+            */
             [[nodiscard]] reference operator[](size_type pos) {
                 if (pos >= size())
                     base_t::resize(pos);
 
+                _mark(pos, true);
                 return base_t::operator[](pos);
             }
 
@@ -235,27 +283,81 @@ namespace hex::containers {
             using base_t::max_size;
             using base_t::reserve;
             using base_t::capacity;
-            using base_t::shrink_to_fit;
             //[[nodiscard]] bool empty() const noexcept;
             //[[nodiscard]] size_type size() const noexcept;
             //[[nodiscard]] size_type max_size() const noexcept;
             //void reserve(size_type new_cap);
             //[[nodiscard]] size_type capacity() const noexcept;
             //void shrink_to_fit();
+
+            void shrink_to_fit() {
+                base_t::shrink_to_fit();
+                _present.shrink_to_fit();
+            }
+            /** @} */
+
+            /**
+            ** \name Presence
+            */
+            /** @{ */
+            /**
+            ** \brief Find the first slot in [pos, last) that may hold a value.
+            **
+            ** Words of 64 empty slots are skipped at once. The slot found may still be empty, e.g. if it was only
+            ** read through operator[], so callers must check it.
+            **
+            ** \return Index of the slot, or last if there is none.
+            */
+            [[nodiscard]] size_type next_present(size_type pos, size_type last) const noexcept {
+                size_type end = std::min(last, size());
+
+                if (pos >= end)
+                    return last;
+
+                size_type word = pos / word_bits;
+
+                if (word >= _present.size())
+                    return last;
+
+                std::uint64_t bits = _present[word] & (~std::uint64_t{0} << (pos % word_bits));
+
+                while (!bits) {
+                    if (++word >= _present.size() || word * word_bits >= end)
+                        return last;
+
+                    bits = _present[word];
+                }
+
+                size_type found = word * word_bits + std::countr_zero(bits);
+
+                return found < end ? found : last;
+            }
+
+            /**
+            ** \brief Number of slots that may hold a value.
+            **
+            ** This is an upper bound of the number of values, exact if the array was only modified through insert_at,
+            ** emplace_at and erase_at.
+            */
+            [[nodiscard]] size_type present_count() const noexcept { return _count; }
             /** @} */
 
             /**
             ** \name Modifier
             */
             /** @{ */
-            using base_t::clear;
-            //void clear() noexcept;
+            void clear() noexcept {
+                base_t::clear();
+                _present.clear();
+                _count = 0;
+            }
 
             template <typename U = T>
             iterator insert_at(size_type pos, U && value) {
                 _maybe_resize(pos);
 
                 base_t::at(pos) = std::forward<U>(value);
+                _mark(pos, base_t::operator[](pos).has_value());
                 return base_t::begin() + pos;
             }
 
@@ -272,6 +374,7 @@ namespace hex::containers {
 
                 traits_t::destroy(alloc, addr);
                 traits_t::construct(alloc, addr, std::forward<Args>(args)...);
+                _mark(pos, addr->has_value());
 
                 return base_t::begin() + pos;
             }
@@ -289,16 +392,36 @@ namespace hex::containers {
 
                 traits_t::destroy(alloc, addr);
                 traits_t::construct(alloc, addr, std::in_place, std::forward<Args>(args)...);
+                _mark(pos, true);
 
                 return base_t::begin() + pos;
             }
 
             void erase_at(size_type pos) {
-                at(pos) = std::nullopt;
+                base_t::at(pos) = std::nullopt;
+                _mark(pos, false);
+            }
+
+            void resize(size_type count) {
+                base_t::resize(count);
+                _truncate_presence(count);
+            }
+
+            void resize(size_type count, value_type const &value) {
+                size_type old = size();
+
+                base_t::resize(count, value);
+                _truncate_presence(count);
+
+                for (size_type pos = old; value && pos < count; ++pos)
+                    _mark(pos, true);
             }
 
-            using base_t::resize;
-            using base_t::swap;
+            void swap(sparse_array &oth) noexcept {
+                base_t::swap(oth);
+                _present.swap(oth._present);
+                std::swap(_count, oth._count);
+            }
             /** @} */
 
             //template <typename T_, class Allocator_> friend bool operator==(sparse_array<T_, Allocator_> const &lhs, sparse_array<T_, Allocator_> const &rhs);
@@ -313,7 +436,70 @@ namespace hex::containers {
                     base_t::resize(pos + 1);
             }
 
+            /**
+            ** \brief Set or clear the presence bit of the slot at pos.
+            */
+            void _mark(size_type pos, bool present) {
+                size_type word = pos / word_bits;
+                std::uint64_t bit = std::uint64_t{1} << (pos % word_bits);
+
+                if (word >= _present.size()) {
+                    if (!present)
+                        return;
+
+                    _present.resize(word + 1);
+                }
+
+                if (static_cast<bool>(_present[word] & bit) != present) {
+                    _present[word] ^= bit;
+                    present ? ++_count : --_count;
+                }
+            }
+
+            /**
+            ** \brief Clear the presence bits of the slots at count and after.
+            */
+            void _truncate_presence(size_type count) {
+                if (_present.size() * word_bits <= count)
+                    return;
+
+                _present.resize((count + word_bits - 1) / word_bits);
+                if (count % word_bits)
+                    _present.back() &= ~(~std::uint64_t{0} << (count % word_bits));
+
+                _count = _count_presence(_present);
+            }
+
+            void _rebuild_presence() {
+                _present = _scan_presence(*this);
+                _count = _count_presence(_present);
+            }
+
+            static std::vector<std::uint64_t> _scan_presence(base_t const &values) {
+                std::vector<std::uint64_t> present((values.size() + word_bits - 1) / word_bits);
+
+                for (size_type pos = 0; pos < values.size(); ++pos)
+                    if (values[pos])
+                        present[pos / word_bits] |= std::uint64_t{1} << (pos % word_bits);
+
+                return present;
+            }
+
+            static size_type _count_presence(std::vector<std::uint64_t> const &present) {
+                size_type count = 0;
+
+                for (std::uint64_t bits : present)
+                    count += std::popcount(bits);
+
+                return count;
+            }
+
             static constexpr std::optional<T> _nullopt{std::nullopt};
+            static constexpr size_type word_bits = 64;
+
+            // Initialized after the values, including by the inherited constructors.
+            std::vector<std::uint64_t> _present = _scan_presence(*this); /**< One bit per slot that may hold a value. */
+            size_type _count = _count_presence(_present); /**< Number of set bits in _present. */
     };
 
     /**
@@ -4,6 +4,7 @@
 #include <hex/events/dispatcher.hpp>
 #include <hex/events/callbacks.hpp>
 #include <hex/events/queues.hpp>
+#include <hex/events/thread_pool.hpp>
 #include <hex/events/utils.hpp>
 
 /**
@@ -17,7 +18,7 @@
 **
 ** ### Callback based events
 ** When callback based events are dispatched, every callback is called with
-** a copy of the event.
+** a reference to the event.
 **
 ** #### Callback dispatch policy
 ** There are currently three
@@ -26,15 +27,30 @@
 ** - \ref hex::events::callbacks::dispatch_policy::sync "Synchronous":
 **   The event is dispatched in the calling thread.
 ** - \ref hex::events::callbacks::dispatch_policy::async "Asynchronous":
-**   The event is dispatched as if in a different thread
+**   The event is dispatched on a worker of the dispatcher's
+**   \ref hex::events::thread_pool "thread pool". Events of a given type are
+**   delivered in dispatch order, and workers run events of higher
+**   \ref hex::events::priority "priority lanes" first.
 ** - \ref hex::events::callbacks::dispatch_policy::trigger "Trigger based":
-**   The events will be dispatched then triggered, in the triggering thread.
+**   The events are buffered per type, and delivered as a single batch upon
+**   \ref hex::events::dispatcher::trigger "trigger", in the triggering
+**   thread, or upon \ref hex::events::dispatcher::trigger_async
+**   "trigger_async", on the thread pool.
 **
 ** ### Polling base events
 ** Polling based events are managed via a queue, that can be polled, either to
 ** retrieve one event, or every pending events. The queue should be cleared
 ** regularly, so it doesn't overload the memory.
 ** \warning Queue are never cleared automatically by the dispatcher.
+**
+** Polling events declared with
+** \ref hex::events::queues::policies::mpsc "policies::mpsc" can be dispatched
+** from several threads at once, without locking.
+**
+** Polling events declared with
+** \ref hex::events::queues::policies::coalesce "policies::coalesce" hold at
+** most one pending event per key: events superseding a pending one are
+** merged into it.
 */
 namespace hex::events {
 }
@@ -3,15 +3,33 @@
 
 #include <any> // std::any
 #include <functional>
+#include <memory>
+#include <span>
 #include <typeindex>
+#include <utility>
+#include <vector>
 
 #include <hex/events/forward.hpp>
+#include <hex/utils/inplace_function.hpp>
 #include <hex/utils/metaprog.hpp>
 #include <hex/events/utils.hpp>
 
 namespace hex::events {
+    /**
+    ** \brief Callback taking batches of events.
+    */
+    template <typename Callable, typename Event>
+    concept BulkEventCallback = std::is_invocable_r_v<void, Callable, std::span<Event const>>;
+
+    /**
+    ** \brief Callback taking a single event, or a batch of events.
+    **
+    ** A callback taking a std::span<Event const>, and not an Event, is
+    ** called once per batch by dispatcher::dispatch_bulk, and with a batch of
+    ** one event by dispatcher::dispatch.
+    */
     template < typename Callable, typename Event>
-    concept EventCallback = std::is_invocable_r_v<void, Callable, Event>;
+    concept EventCallback = std::is_invocable_r_v<void, Callable, Event const &> || BulkEventCallback<Callable, Event>;
 }
 
 namespace hex::events::callbacks {
@@ -20,7 +38,7 @@ namespace hex::events::callbacks {
     */
     enum class dispatch_policy {
         async, /**< Event are to be ran asynchronously. */
-        trigger, /**< Event are handled lazily at a later point. */
+        trigger, /**< Event are buffered, and handled in a single batch by dispatcher::trigger. */
         sync, /**< Event are handled as soon as they are dispatched, on the calling thread */
     };
 
@@ -38,7 +56,7 @@ namespace hex::events::callbacks {
     class handle {
         friend hex::events::callbacks::container;
 
-        handle(std::type_index ti, std::size_t id): _ti(ti), _id(id) {}
+        handle(std::type_index ti, std::size_t slot, std::size_t generation): _ti(ti), _slot(slot), _generation(generation) {}
 
         public:
         handle(handle const &) = default;
@@ -48,7 +66,7 @@ namespace hex::events::callbacks {
         handle &operator=(handle &&) = default;
 
         friend bool operator==(handle const &lhs, handle const &rhs) {
-            return lhs._ti == rhs._ti && lhs._id == rhs._id;
+            return lhs._ti == rhs._ti && lhs._slot == rhs._slot && lhs._generation == rhs._generation;
         }
 
         std::type_index type_index() const {
@@ -57,7 +75,8 @@ namespace hex::events::callbacks {
 
         private:
         std::type_index _ti;
-        std::size_t _id;
+        std::size_t _slot; /**< Index of the callback slot. */
+        std::size_t _generation; /**< Number of times the slot was reused. */
     };
 
     /**
@@ -67,40 +86,83 @@ namespace hex::events::callbacks {
     ** the \ref hex::events::dispatcher "dispatcher" to holds every events
     ** callbacks in a single container.
     **
+    ** Callbacks are stored contiguously in \ref utils::inplace_function
+    ** "inplace functions", so dispatching never allocates nor copies the
+    ** event. Handles refer to slots, mapping them to the callback position,
+    ** so that unregistering a callback is constant time: it is emptied in
+    ** place, and skipped by dispatch. Emptied callbacks are removed upon the
+    ** next registration, or once they outnumber the others, so that
+    ** callbacks stay in registration order.
+    **
     ** \note This is meant for internal use only.
     */
     class container {
         /**
         ** \brief Callback storage type.
         **
-        ** Holds a callback for a given event, as well as a copy of its handle.
+        ** Holds a callback for a given event, as well as the slot of its
+        ** handle.
+        **
+        ** Every callback is stored as a callable taking a batch of events:
+        ** callbacks taking single events are wrapped into a loop over the
+        ** batch, and single events are dispatched as batches of one.
         **
         ** \note This is meant for internal use only.
         */
         template <typename Event>
         struct functor {
-            handle hndl;
-            std::function<void(Event)> callback;
+            std::size_t slot;
+            utils::inplace_function<void(std::span<Event const>)> callback;
 
             /**
             ** \brief construct the functor.
             */
-            template <EventCallback<Event> Callable> functor(handle _hndl, Callable && c)
-                : hndl(_hndl), callback(std::forward<Callable>(c)) {}
+            template <EventCallback<Event> Callable> functor(std::size_t _slot, Callable && c) : slot(_slot) {
+                // Checked first, so that generic callbacks are never instantiated with a span.
+                if constexpr (std::is_invocable_r_v<void, Callable, Event const &>) {
+                    callback = [c = std::forward<Callable>(c)](std::span<Event const> events) mutable {
+                        for (Event const &e : events)
+                            std::invoke(c, e);
+                    };
+                } else {
+                    callback = std::forward<Callable>(c);
+                }
+            }
 
             /**
-            ** \brief Call the held callback, with a copy of the event.
+            ** \brief Call the held callback once with the whole batch if it
+            ** takes batches, or once per event otherwise.
             */
-            void operator()(Event e) const {
-                callback(e);
+            void operator()(std::span<Event const> events) const {
+                callback(events);
             }
         };
 
+        /**
+        ** \brief Position of a callback, and generation of its handle.
+        */
+        struct slot {
+            std::size_t pos;
+            std::size_t generation;
+        };
+
         /**
         ** \brief internal container implementation.
         */
         template <typename EventType>
-        using container_impl = std::vector<functor<EventType>>;
+        struct container_impl {
+            std::vector<functor<EventType>> callbacks; /**< Registered callbacks, contiguous, including emptied ones. */
+            std::vector<slot> slots; /**< Indexed by handle. */
+            std::vector<std::size_t> free; /**< Slots of unregistered callbacks, to reuse. */
+            std::size_t dead = 0; /**< Number of emptied callbacks, waiting to be removed. */
+        };
+
+        /**
+        ** \brief type held by the std::any, since callbacks cannot be
+        ** copied.
+        */
+        template <typename EventType>
+        using impl_ptr = std::shared_ptr<container_impl<EventType>>;
 
         /**
         ** \name Helper functions
@@ -120,25 +182,54 @@ namespace hex::events::callbacks {
         */
         template <typename Event, typename Any>
         static copy_cvref_t<container_impl<Event>, Any> _cast_callback(Any &&container) {
-            return std::any_cast<copy_cvref_t<container_impl<Event>, Any>>(std::forward<Any>(container));
+            return *std::any_cast<copy_cvref_t<impl_ptr<Event>, Any>>(std::forward<Any>(container));
+        }
+
+        /**
+        ** \brief remove the emptied callbacks, keeping the order of the
+        ** others, and update their slots.
+        */
+        template <typename Event>
+        static void _compact(container_impl<Event> &impl) {
+            std::erase_if(impl.callbacks, [](functor<Event> const &f) { return !f.callback; });
+
+            for (std::size_t i = 0; i < impl.callbacks.size(); ++i)
+                impl.slots[impl.callbacks[i].slot].pos = i;
+
+            impl.dead = 0;
         }
 
         /**
         ** \brief unregister the callback corresponding to the handle.
         **
+        ** The callback is emptied in place, and its slot freed, in constant
+        ** time. Emptied callbacks are removed once they outnumber the others,
+        ** so that dispatch does not skip more callbacks than it calls.
+        **
         ** \tparam Event The type of Event the callback are meant for.
         **
         ** \param hndl Callback handle.
         **
-        ** \return true if the callback was removed.
+        ** \return Number of callbacks left.
         */
         template <typename Event>
         static std::size_t _unregister_impl(container &m, handle hndl) {
-            auto &callbacks = _cast_callback<Event>(m._callbacks);
+            auto &impl = _cast_callback<Event>(m._callbacks);
+
+            if (hndl._slot >= impl.slots.size() || impl.slots[hndl._slot].generation != hndl._generation)
+                return impl.callbacks.size() - impl.dead;
+
+            slot &s = impl.slots[hndl._slot];
 
-            std::erase_if(callbacks, [&](auto cb){ return cb.hndl == hndl; });
+            impl.callbacks[s.pos].callback.reset();
+            ++impl.dead;
+            ++s.generation;
+            impl.free.push_back(hndl._slot);
 
-            return callbacks.size();
+            if (impl.dead * 2 > impl.callbacks.size())
+                _compact(impl);
+
+            return impl.callbacks.size() - impl.dead;
         }
 
         using unregister_f = std::size_t(container &, handle);
@@ -154,6 +245,20 @@ namespace hex::events::callbacks {
             return c.dispatch(std::any_cast<Event const &>(ev));
         }
         using dispatch_any_f = void(container const &, std::any const &);
+
+        /**
+        ** \brief defer an event stored in a std::any.
+        */
+        template <typename Event>
+        static void _defer_any_impl(container &c, std::any const & ev) {
+            c.defer(std::any_cast<Event const &>(ev));
+        }
+        using defer_any_f = void(container &, std::any const &);
+
+        template <typename Event>
+        std::vector<Event> &_deferred_events() {
+            return std::any_cast<std::vector<Event> &>(_deferred);
+        }
         /**@}*/
 
         public:
@@ -161,8 +266,9 @@ namespace hex::events::callbacks {
         container(for_event_t<Event>) :
             _unregister(_unregister_impl<Event>),
             _dispatch_any(_dispatch_any_impl<Event>),
-            _count(0),
-            _callbacks(std::in_place_type<std::vector<functor<Event>>>)
+            _defer_any(_defer_any_impl<Event>),
+            _callbacks(std::make_shared<container_impl<Event>>()),
+            _deferred(std::in_place_type<std::vector<Event>>)
         {}
 
         container(container const &) = delete;
@@ -174,8 +280,9 @@ namespace hex::events::callbacks {
         /**
         ** \brief dispatch a single event.
         **
-        ** Upon dispatch, every callback is called, in the order in which they
-        ** were registered.
+        ** Upon dispatch, every callback is called with a reference to the
+        ** event, in the order in which they were registered. Unregistered
+        ** callbacks are skipped, so the others keep their order.
         **
         ** \tparam Event Type of the event to be dispatched.
         **
@@ -183,10 +290,26 @@ namespace hex::events::callbacks {
         */
         template <typename Event>
         void dispatch(Event const &ev) const {
-            auto const &callbacks = _cast_callback<Event>(_callbacks);
+            dispatch_bulk(std::span<Event const>{&ev, 1});
+        }
+
+        /**
+        ** \brief dispatch a batch of events.
+        **
+        ** Every callback is called, in the same order as dispatch, either
+        ** once with the whole batch, or once per event.
+        **
+        ** \tparam Event Type of the events to be dispatched.
+        **
+        ** \param events Events to be dispatched.
+        */
+        template <typename Event>
+        void dispatch_bulk(std::span<Event const> events) const {
+            auto const &callbacks = _cast_callback<Event>(_callbacks).callbacks;
 
             for (auto const &f : callbacks)
-                f(ev);
+                if (f.callback)
+                    f(events);
         }
 
         /**
@@ -201,11 +324,79 @@ namespace hex::events::callbacks {
             _dispatch_any(*this, ev);
         }
 
+        /**
+        ** \brief buffer an event, until the next flush.
+        **
+        ** \tparam Event Type of the event to be deferred.
+        **
+        ** \param ev Event to be deferred.
+        */
+        template <typename Event>
+        void defer(Event const &ev) {
+            _deferred_events<Event>().push_back(ev);
+        }
+
+        /**
+        ** \brief buffer a batch of events, until the next flush.
+        */
+        template <typename Event>
+        void defer_bulk(std::span<Event const> events) {
+            auto &deferred = _deferred_events<Event>();
+
+            deferred.insert(deferred.end(), events.begin(), events.end());
+        }
+
+        /**
+        ** \brief buffer a type-erased event.
+        **
+        ** \param ev std::any wrapping an event.
+        */
+        void defer(std::any const &ev) {
+            _defer_any(*this, ev);
+        }
+
+        /**
+        ** \brief take every deferred event, leaving none.
+        */
+        template <typename Event>
+        std::vector<Event> take_deferred() {
+            return std::exchange(_deferred_events<Event>(), {});
+        }
+
+        /**
+        ** \brief dispatch every deferred event, as a single batch.
+        **
+        ** Events deferred by the callbacks are kept for the next flush. The
+        ** buffer is reused, so that deferring events does not allocate once
+        ** it has grown large enough.
+        **
+        ** \return Number of events dispatched.
+        */
+        template <typename Event>
+        std::size_t flush() {
+            if (_deferred_events<Event>().empty())
+                return 0;
+
+            std::vector<Event> batch;
+            std::swap(batch, _deferred_events<Event>());
+
+            dispatch_bulk(std::span<Event const>{batch});
+
+            std::size_t count = batch.size();
+            batch.clear();
+
+            if (_deferred_events<Event>().empty())
+                std::swap(batch, _deferred_events<Event>());
+
+            return count;
+        }
+
         /**
         ** \brief register a single callback for a given event type.
         **
         ** \tparam Event Type of event the callback manages.
-        ** \tparam Callable Callable type that can handle the event.
+        ** \tparam Callable Callable type that can handle the event. Its
+        ** captures must fit in an utils::inplace_function.
         **
         ** \param c Callback to register.
         **
@@ -213,13 +404,23 @@ namespace hex::events::callbacks {
         */
         template <typename Event, EventCallback<Event> Callable>
         handle register_callback(Callable && c) {
-            std::vector<functor<Event>> & callbacks = _cast_callback<Event>(_callbacks);
+            container_impl<Event> & impl = _cast_callback<Event>(_callbacks);
+
+            if (impl.dead)
+                _compact(impl);
+
+            std::size_t idx = impl.free.empty() ? impl.slots.size() : impl.free.back();
 
-            functor<Event> &cb = callbacks.emplace_back(
-                    handle{typeid(Event), ++_count},
-                    std::forward<Callable>(c));
+            impl.callbacks.emplace_back(idx, std::forward<Callable>(c));
+
+            if (idx == impl.slots.size()) {
+                impl.slots.push_back({impl.callbacks.size() - 1, 0});
+            } else {
+                impl.free.pop_back();
+                impl.slots[idx].pos = impl.callbacks.size() - 1;
+            }
 
-            return cb.hndl;
+            return handle{typeid(Event), idx, impl.slots[idx].generation};
         }
 
         /**
@@ -236,9 +437,10 @@ namespace hex::events::callbacks {
         private:
         unregister_f * _unregister;
         dispatch_any_f * _dispatch_any;
+        defer_any_f * _defer_any;
 
-        std::size_t _count; /**< number of callbacks added. */
-        std::any _callbacks; /**< type-erased list of callbacks */
+        std::any _callbacks; /**< type-erased callbacks */
+        std::any _deferred; /**< type-erased vector of events waiting for a trigger */
     };
 }
 
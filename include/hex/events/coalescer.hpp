@@ -0,0 +1,89 @@
+#ifndef hex_mpi_events_coalescer_hpp_
+#define hex_mpi_events_coalescer_hpp_
+
+#include <cstddef> // std::size_t
+#include <functional> // std::invoke
+#include <type_traits> // std::invoke_result_t, std::remove_cvref_t
+#include <unordered_map> // std::unordered_map
+#include <utility> // std::move
+#include <vector> // std::vector
+
+namespace hex::events::queues {
+    /**
+    ** \brief Merges pushed events into the pending event of the same key, if
+    ** any.
+    **
+    ** Pending events are the events [next, size()) of a queue's vector.
+    ** Events before next were polled already, and are never merged into.
+    **
+    ** \tparam Event type of the events.
+    */
+    template <typename Event>
+    class coalescer {
+        public:
+            virtual ~coalescer() = default;
+
+            /**
+            ** \brief merge ev into the pending event of the same key, or
+            ** append it to events.
+            */
+            virtual void push(std::vector<Event> &events, std::size_t next, Event const &ev) = 0;
+
+            /**
+            ** \brief forget every pending event, once events was emptied.
+            */
+            virtual void reset() noexcept = 0;
+
+            /**
+            ** \brief index the pending events again, once they were moved
+            ** within events.
+            */
+            virtual void reindex(std::vector<Event> const &events, std::size_t next) = 0;
+    };
+
+    /**
+    ** \brief Coalescer keeping the position of the pending event of each key
+    ** in a hash map.
+    **
+    ** \tparam Event type of the events.
+    ** \tparam KeyFn Callable returning the key of an Event const &.
+    ** \tparam Reduce Callable merging an Event const & into a pending Event &.
+    */
+    template <typename Event, typename KeyFn, typename Reduce>
+    class keyed_coalescer : public coalescer<Event> {
+        using key_type = std::remove_cvref_t<std::invoke_result_t<KeyFn &, Event const &>>;
+
+        public:
+            keyed_coalescer(KeyFn key, Reduce reduce) : _key(std::move(key)), _reduce(std::move(reduce)) {}
+
+            void push(std::vector<Event> &events, std::size_t next, Event const &ev) override {
+                auto [it, inserted] = _pending.try_emplace(std::invoke(_key, ev), events.size());
+
+                if (!inserted && it->second >= next) {
+                    std::invoke(_reduce, events[it->second], ev);
+                    return;
+                }
+
+                it->second = events.size();
+                events.push_back(ev);
+            }
+
+            void reset() noexcept override {
+                _pending.clear();
+            }
+
+            void reindex(std::vector<Event> const &events, std::size_t next) override {
+                _pending.clear();
+
+                for (std::size_t i = next; i < events.size(); ++i)
+                    _pending.insert_or_assign(std::invoke(_key, events[i]), i);
+            }
+
+        private:
+            KeyFn _key;
+            Reduce _reduce;
+            std::unordered_map<key_type, std::size_t> _pending; /**< Position of the last pushed event of each key. */
+    };
+}
+
+#endif /* end of include guard: hex_mpi_events_coalescer_hpp_ */
@@ -1,16 +1,32 @@
 #ifndef hex_mpi_events_dispatcher_hpp_
 #define hex_mpi_events_dispatcher_hpp_
 
-#include <future>
+#include <any>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <type_traits>
 #include <typeindex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <hex/events/callbacks.hpp>
+#include <hex/events/forward.hpp>
 #include <hex/events/queues.hpp>
+#include <hex/events/thread_pool.hpp>
+#include <hex/tracing/sink.hpp>
+#include <hex/utils/concepts.hpp>
 
 namespace hex::events {
+    using concepts::one_of;
+
     /**
     ** \brief Tags to control event handling flavor
     */
@@ -48,24 +64,322 @@ namespace hex::events {
     };
 
     namespace __impl {
-        template <typename T>
-        std::type_info const & get_type_info(T && t) {
-            if constexpr (std::is_same_v<std::any, std::remove_cvref_t<T>>) {
-                return t.type();
-            } else {
-                return typeid(T);
-            }
-        }
+        /**
+        ** \brief Run tasks on a thread pool one at a time, in the order in
+        ** which they were posted.
+        **
+        ** At most one task of a strand is queued in, or run by, the pool: the
+        ** next one is submitted once it returns, so that tasks of other
+        ** strands, and of higher lanes, run in between. Each submitted task
+        ** holds the pool, which thus stays alive while the strand has tasks
+        ** left, even if its dispatcher switched to another pool.
+        */
+        class strand : public std::enable_shared_from_this<strand> {
+            public:
+                /**
+                ** \brief post a task, to run after every task posted before.
+                **
+                ** If the strand is idle, the task is submitted to pool, in
+                ** lane. Otherwise, it follows the previous tasks on their
+                ** pool.
+                **
+                ** \warning The task must not throw.
+                */
+                void post(std::shared_ptr<thread_pool> pool, priority lane, std::function<void()> task) {
+                    {
+                        std::lock_guard lock{_mutex};
+                        _tasks.push_back(std::move(task));
+
+                        if (std::exchange(_scheduled, true))
+                            return;
+                    }
+
+                    _submit(std::move(pool), lane);
+                }
+
+            private:
+                void _submit(std::shared_ptr<thread_pool> pool, priority lane) {
+                    thread_pool &p = *pool;
+
+                    p.submit([self = shared_from_this(), pool = std::move(pool), lane]() mutable {
+                        self->_run_one(std::move(pool), lane);
+                    }, lane);
+                }
+
+                void _run_one(std::shared_ptr<thread_pool> pool, priority lane) {
+                    std::function<void()> task;
+
+                    {
+                        std::lock_guard lock{_mutex};
+                        task = std::move(_tasks.front());
+                        _tasks.pop_front();
+                    }
+
+                    task();
+
+                    {
+                        std::lock_guard lock{_mutex};
+
+                        if (_tasks.empty()) {
+                            _scheduled = false;
+                            return;
+                        }
+                    }
+
+                    _submit(std::move(pool), lane);
+                }
+
+            private:
+                std::mutex _mutex;
+                std::deque<std::function<void()>> _tasks;
+                bool _scheduled = false; /**< Whether a task of this strand is queued in, or run by, a pool. */
+        };
+
+        /**
+        ** \brief State of a single event type, in a dispatcher.
+        **
+        ** Callbacks and queues are kept on the heap, so that pending tasks
+        ** still refer to them when slots are moved.
+        */
+        struct event_slot {
+            std::optional<event_kind> kind; /**< Empty until the type is declared. */
+            std::optional<callbacks::dispatch_policy> policy;
+            priority lane = priority::normal;
+            std::unique_ptr<callbacks::container> callbacks;
+            std::unique_ptr<queues::event_queue> queue;
+            std::shared_ptr<strand> async; /**< Asynchronous deliveries, for callback-style events. */
+        };
+
+        /**
+        ** \brief Count the tasks a dispatcher submitted to a thread_pool, to
+        ** wait for them.
+        **
+        ** The counter lives on the heap, so that tasks still refer to it once
+        ** the dispatcher is moved. Destroying or assigning to a tracker
+        ** first waits for its pending tasks.
+        */
+        class async_tracker {
+            struct state {
+                std::mutex mutex;
+                std::condition_variable done;
+                std::size_t pending = 0;
+                std::exception_ptr error;
+            };
+
+            public:
+                async_tracker() : _state(std::make_unique<state>()) {}
+                async_tracker(async_tracker &&) noexcept = default;
+
+                async_tracker &operator=(async_tracker &&other) noexcept {
+                    if (this != &other) {
+                        wait();
+                        _state = std::move(other._state);
+                    }
+
+                    return *this;
+                }
+
+                ~async_tracker() { wait(); }
+
+                /**
+                ** \brief count a task until it returns.
+                **
+                ** The first exception escaping a task is kept for wait.
+                **
+                ** \return the task to run in its stead, which never throws.
+                */
+                template <typename Task>
+                auto track(Task &&task) {
+                    state *st = _state.get();
+
+                    {
+                        std::lock_guard lock{st->mutex};
+                        ++st->pending;
+                    }
+
+                    return [st, task = std::forward<Task>(task)]() mutable {
+                        std::exception_ptr error;
+
+                        try {
+                            task();
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+
+                        std::lock_guard lock{st->mutex};
+
+                        if (error && !st->error)
+                            st->error = error;
+
+                        // Notifying under the lock: the waiter may destroy the state as soon as it sees no pending task.
+                        if (--st->pending == 0)
+                            st->done.notify_all();
+                    };
+                }
+
+                /**
+                ** \brief wait until no task is pending.
+                **
+                ** \return the first exception that escaped a task since the
+                ** last wait, if any.
+                */
+                std::exception_ptr wait() noexcept {
+                    if (!_state)
+                        return nullptr;
+
+                    std::unique_lock lock{_state->mutex};
+                    _state->done.wait(lock, [this]{ return _state->pending == 0; });
+
+                    return std::exchange(_state->error, nullptr);
+                }
+
+            private:
+                std::unique_ptr<state> _state;
+        };
+
+        /**
+        ** \brief Thread pool of a dispatcher, created upon first use unless
+        ** one is given.
+        **
+        ** The pool and its std::once_flag live on the heap, so that
+        ** concurrent asynchronous dispatches create a single pool, and the
+        ** dispatcher stays movable.
+        */
+        class lazy_pool {
+            struct state {
+                std::once_flag created;
+                std::shared_ptr<thread_pool> pool;
+            };
+
+            public:
+                explicit lazy_pool(std::shared_ptr<thread_pool> pool = nullptr) : _state(std::make_unique<state>()) {
+                    _state->pool = std::move(pool);
+                }
+
+                /**
+                ** \brief get the pool, creating it on the first call if none
+                ** was given.
+                */
+                std::shared_ptr<thread_pool> const &get() const {
+                    state *st = _state.get();
+
+                    std::call_once(st->created, [st]{
+                        if (!st->pool)
+                            st->pool = std::make_shared<thread_pool>();
+                    });
+
+                    return st->pool;
+                }
+
+                /**
+                ** \brief use another pool, or a pool of its own, created upon
+                ** first use, if pool is nullptr.
+                **
+                ** \warning Must not be called concurrently with get.
+                */
+                void set(std::shared_ptr<thread_pool> pool) {
+                    *this = lazy_pool{std::move(pool)};
+                }
+
+            private:
+                std::unique_ptr<state> _state;
+        };
     }
 
+    /**
+    ** \brief Event ids of a dispatcher, for an open set of event types.
+    **
+    ** Ids are the process-wide \ref event_id "dense ids", and per-type state
+    ** is stored in a vector, grown as event types are declared.
+    */
+    struct dynamic_ids {
+        using slots = std::vector<__impl::event_slot>;
+
+        template <typename Event>
+        static std::size_t id() noexcept {
+            return event_id<Event>();
+        }
+
+        static __impl::event_slot const *find(slots const &s, std::size_t id) noexcept {
+            return id < s.size() ? &s[id] : nullptr;
+        }
+
+        static __impl::event_slot &get(slots &s, std::size_t id) {
+            if (id >= s.size())
+                s.resize(id + 1);
+
+            return s[id];
+        }
+    };
+
+    /**
+    ** \brief Event ids of a dispatcher, for a closed set of event types.
+    **
+    ** Ids are the positions of the types in Events, known at compile time,
+    ** and per-type state is stored in an array.
+    */
+    template <typename... Events>
+    struct static_ids {
+        using slots = std::array<__impl::event_slot, sizeof...(Events)>;
+
+        template <typename Event>
+        static constexpr std::size_t id() noexcept {
+            static_assert(one_of<Event, Events...>, "Event is not handled by this static_dispatcher.");
+
+            std::size_t i = 0;
+            ((std::is_same_v<Event, Events> ? false : (++i, true)) && ...);
+
+            return i;
+        }
+
+        static __impl::event_slot const *find(slots const &s, std::size_t id) noexcept {
+            return &s[id];
+        }
+
+        static __impl::event_slot &get(slots &s, std::size_t id) noexcept {
+            return s[id];
+        }
+    };
+
     /**
     ** \brief Event dispatcher.
+    **
+    ** Every event type is mapped to a dense id by Ids, and all of its state
+    ** (kind, policy, callbacks and queue) is kept in a single slot, indexed
+    ** by that id: dispatching an event is one indexed load, without hashing.
+    ** Events wrapped in a std::any are the exception, and are mapped to their
+    ** id through a hash map.
+    **
+    ** Callbacks with the async policy run on a \ref thread_pool "thread pool",
+    ** in the \ref set_priority_for "priority lane" of their event type.
+    ** Events of a given type are delivered one at a time, in dispatch order.
+    ** Unless one is given, the dispatcher creates its own pool upon the first
+    ** asynchronous dispatch.
+    **
+    ** \see dispatcher, static_dispatcher
+    **
+    ** \tparam Ids Mapping from event types to ids, either dynamic_ids or
+    ** static_ids.
     */
-    class dispatcher {
+    template <class Ids>
+    class basic_dispatcher {
         public:
-            dispatcher() {}
-            dispatcher(dispatcher &&other) = default;
-            dispatcher & operator=(dispatcher && other) = default;
+            basic_dispatcher() {}
+
+            /**
+            ** \brief construct a dispatcher running asynchronous callbacks on
+            ** pool.
+            */
+            explicit basic_dispatcher(std::shared_ptr<thread_pool> pool) : _pool(std::move(pool)) {}
+
+            basic_dispatcher(basic_dispatcher &&other) = default;
+            basic_dispatcher & operator=(basic_dispatcher && other) = default;
+
+            /**
+            ** \brief wait for pending asynchronous callbacks, then destroy the
+            ** dispatcher.
+            */
+            ~basic_dispatcher() { _async.wait(); }
 
             /**
             ** \brief Declare a callback-style event.
@@ -76,61 +390,65 @@ namespace hex::events {
             */
             template <typename Event>
             bool declare(kind::callback_t<Event>, callbacks::dispatch_policy policy = callbacks::dispatch_policy::async) {
-                std::type_index idx = typeid(Event);
-                auto [it, ok] = _event_kinds.try_emplace(idx, event_kind::callback);
+                __impl::event_slot &slot = _slot<Event>();
+
+                if (!slot.kind) {
+                    slot.kind = event_kind::callback;
+                    slot.callbacks = std::make_unique<callbacks::container>(for_event<Event>);
+                    slot.async = std::make_shared<__impl::strand>();
 
-                if (ok) {
-                    _callbacks.try_emplace(idx, for_event<Event>);
-                    _callbacks_policies.try_emplace(idx, policy);
+                    if (!slot.policy)
+                        slot.policy = policy;
                 }
 
-                return ok || it->second == event_kind::callback;
+                return slot.kind == event_kind::callback;
             }
 
-            /**@{*/
             /**
             ** \brief Declare a polling-style event.
             **
+            ** Policies can be given in any order, at most one of each kind:
+            **  - a PendingPolicy, applied on event_queue::clear(). Defaults to
+            **    queues::policies::clear_pending.
+            **  - a ShrinkPolicy, applied on event_queue::clear(). Defaults to
+            **    queues::policies::no_shrink.
+            **  - a ProducerPolicy. Defaults to
+            **    queues::policies::single_producer. With queues::policies::mpsc,
+            **    several threads can dispatch the event at once.
+            **  - a StoragePolicy. Defaults to queues::policies::unbounded. With
+            **    queues::policies::bounded, the queue has a fixed capacity.
+            **    With queues::policies::coalesce, events of the same key are
+            **    merged until polled.
+            **
             ** \tparam Event type of the event.
-            ** \tparam P PendingPolicy to be applied on event_queue::clear().
-            ** \tparam S ShrinkPolicy to be applied on event_queue::clear().
+            ** \tparam Policies queue policies.
             **
             ** \return If no error happens, returns true.
             */
-            template <typename Event,
-                     queues::policies::PendingPolicy P,
-                     queues::policies::ShrinkPolicy S>
-            bool declare(kind::polling_t<Event>, P p, S s) {
-                return _declare_polling(for_event<Event>, p, s);
-            }
+            template <typename Event, queues::policies::QueuePolicy... Policies>
+            bool declare(kind::polling_t<Event>, Policies... policies) {
+                using namespace queues::policies;
 
-            template <typename Event>
-            bool declare(kind::polling_t<Event>) {
-                return _declare_polling(for_event<Event>,
-                            queues::policies::clear_pending,
-                            queues::policies::no_shrink
-                        );
-            }
+                static_assert((PendingPolicy<Policies> + ...  + 0) <= 1, "At most one PendingPolicy can be given.");
+                static_assert((ShrinkPolicy<Policies> + ...  + 0) <= 1, "At most one ShrinkPolicy can be given.");
+                static_assert((ProducerPolicy<Policies> + ...  + 0) <= 1, "At most one ProducerPolicy can be given.");
+                static_assert((StoragePolicy<Policies> + ...  + 0) <= 1, "At most one StoragePolicy can be given.");
 
-            template <typename Event, queues::policies::PendingPolicy P>
-            bool declare(kind::polling_t<Event>, P p) {
-                return _declare_polling(for_event<Event>, p, queues::policies::no_shrink);
-            }
-
-            template <typename Event, queues::policies::ShrinkPolicy S>
-            bool declare(kind::polling_t<Event>, S s) {
                 return _declare_polling(for_event<Event>,
-                                        queues::policies::clear_pending,
-                                        s);
+                            pick<is_pending>(clear_pending, policies...),
+                            pick<is_shrink>(no_shrink, policies...),
+                            pick<is_producer>(single_producer, policies...),
+                            pick<is_storage>(unbounded, policies...)
+                        );
             }
-            /**@}*/
 
             /**
             ** \brief Register a callback for a given event type.
             **
             ** This function setup a Callback style events. When an events will
             ** be dispatched, every callback will be called, in the order in
-            ** which they were registered.
+            ** which they were registered. Unregistering a callback keeps the
+            ** order of the others.
             **
             ** \tparam Event Type that will be used when dispatching an event.
             ** \tparam Callback Callback returning void and taking Event as
@@ -141,45 +459,40 @@ namespace hex::events {
             */
             template <typename Event, EventCallback<Event> Callback>
             std::optional<hex::events::callbacks::handle> register_callback_for(Callback && cb) {
-                std::type_index idx = typeid(Event);
+                __impl::event_slot const *slot = Ids::find(_slots, Ids::template id<Event>());
 
-                if (!_event_kinds.contains(idx) || _event_kinds[idx] != event_kind::callback)
+                if (!slot || slot->kind != event_kind::callback)
                     return std::nullopt;
 
-                auto [it, ok] = _callbacks.try_emplace(typeid(Event), events::for_event<Event>);
-
-                return it->second.template register_callback<Event>(std::forward<Callback>(cb));
+                return slot->callbacks->template register_callback<Event>(std::forward<Callback>(cb));
             }
 
             template <typename Event, EventCallback<Event> Callback>
             std::optional<hex::events::callbacks::handle> register_callback_for(Callback && cb, callbacks::dispatch_policy pol) {
-                std::type_index idx = typeid(Event);
-
                 if (!declare(kind::callback<Event>, pol)) { return std::nullopt; }
 
-                auto [it, ok] = _callbacks.try_emplace(typeid(Event), events::for_event<Event>);
-
-                return it->second.template register_callback<Event>(std::forward<Callback>(cb));
+                return _slot<Event>().callbacks->template register_callback<Event>(std::forward<Callback>(cb));
             }
 
             /**
             ** \brief un-registers an event callback.
             **
+            ** The remaining callbacks keep their registration order. Stale
+            ** handles, whose callback was already unregistered, are ignored.
+            **
             ** \param handle hex::events::callbacks::handle to the callback to
             ** remove.
             **
             ** \return Return true if a callback was unregistered
             */
-            dispatcher & unregister_callback(hex::events::callbacks::handle handle) {
-                std::type_index idx = handle.type_index();
+            basic_dispatcher & unregister_callback(hex::events::callbacks::handle handle) {
+                __impl::event_slot const *slot = _find(handle.type_index());
 
-                if (!_callbacks.contains(idx)) {
+                if (!slot || !slot->callbacks) {
                     return *this;
                 }
 
-                auto &container = _callbacks.at(idx);
-
-                container.unregister(handle);
+                slot->callbacks->unregister(handle);
 
                 return *this;
             }
@@ -190,10 +503,25 @@ namespace hex::events {
             ** \tparam Event event type to set policy of.
             */
             template <typename Event>
-            dispatcher & set_policy_for(callbacks::dispatch_policy pol) {
-                std::type_index idx = typeid(Event);
+            basic_dispatcher & set_policy_for(callbacks::dispatch_policy pol) {
+                _slot<Event>().policy = pol;
 
-                _callbacks_policies[idx] = pol;
+                return *this;
+            }
+
+            /**
+            ** \brief set the priority lane of an event type.
+            **
+            ** Asynchronous deliveries of events in a higher lane are run
+            ** first by the thread pool. Deliveries of a given type run one at
+            ** a time, in the order in which they were dispatched, while
+            ** deliveries of other types run in parallel on the other workers.
+            **
+            ** \tparam Event event type to set the priority of.
+            */
+            template <typename Event>
+            basic_dispatcher & set_priority_for(priority lane) {
+                _slot<Event>().lane = lane;
 
                 return *this;
             }
@@ -201,30 +529,59 @@ namespace hex::events {
             /**
             ** \brief trigger callbacks for an event type.
             **
+            ** Events dispatched with the trigger policy since the last trigger
+            ** are delivered in the calling thread, as a single batch: callbacks
+            ** taking a std::span<Event const> are called once.
+            **
             ** \tparam Event The event type to trigger callbacks for.
             */
             template <typename Event>
-            dispatcher const & trigger(for_event_t<Event>) const {
-                std::type_index idx = typeid(Event);
+            basic_dispatcher const & trigger(for_event_t<Event>) const {
+                __impl::event_slot const *slot = Ids::find(_slots, Ids::template id<Event>());
 
-                for (auto const &f : _pending_trigger[idx]) {
-                    f.wait();
+                if (!slot || slot->kind != event_kind::callback) {
+                    return *this;
                 }
 
-                _pending_trigger.erase(idx);
+                tracing::scope s{_trace.get(), typeid(Event).name(), "callbacks"};
+                slot->callbacks->template flush<Event>();
 
                 return *this;
             }
 
             /**
-            ** \brief wait all callback events with async policy.
+            ** \brief trigger callbacks for an event type, on the thread pool.
+            **
+            ** Like trigger, but the batch is delivered by a worker. Its
+            ** completion is waited for by wait_async.
+            **
+            ** \tparam Event The event type to trigger callbacks for.
             */
-            dispatcher const & wait_async() const {
-                for (auto const &f: _pending_callbacks) {
-                    f.wait();
+            template <typename Event>
+            basic_dispatcher const & trigger_async(for_event_t<Event>) const {
+                __impl::event_slot const *slot = Ids::find(_slots, Ids::template id<Event>());
+
+                if (!slot || slot->kind != event_kind::callback) {
+                    return *this;
                 }
 
-                _pending_callbacks.clear();
+                std::vector<Event> batch = slot->callbacks->template take_deferred<Event>();
+
+                if (!batch.empty())
+                    _run_async_bulk(*slot, std::move(batch), typeid(Event).name());
+
+                return *this;
+            }
+
+            /**
+            ** \brief wait all callback events with async policy.
+            **
+            ** \throw Rethrows the first exception that escaped an asynchronous
+            ** callback since the last call, if any.
+            */
+            basic_dispatcher const & wait_async() const {
+                if (std::exception_ptr error = _async.wait())
+                    std::rethrow_exception(error);
 
                 return *this;
             }
@@ -242,21 +599,66 @@ namespace hex::events {
             **
             ** If the event is queue-based, it's pushed into its respective queue.
             **
+            ** Events declared with queues::policies::mpsc can be dispatched
+            ** from several threads at once, as long as no event is declared
+            ** meanwhile.
+            **
             ** \tparam Event type of the event to dispatch
             ** \param ev event to dispatch
             */
             template <typename Event>
-            dispatcher const & dispatch(Event const &ev) const {
-                std::type_index idx = __impl::get_type_info(ev);
+            basic_dispatcher const & dispatch(Event const &ev) const {
+                __impl::event_slot const *slot = nullptr;
+                char const *name = nullptr;
+
+                if constexpr (std::is_same_v<Event, std::any>) {
+                    slot = _find(ev.type());
+                    name = ev.type().name();
+                } else {
+                    slot = Ids::find(_slots, Ids::template id<Event>());
+                    name = typeid(Event).name();
+                }
+
+                tracing::scope trace{_trace.get(), name, "dispatch"};
+
+                if (!slot || !slot->kind) { return *this; }
+
+                if (slot->kind == event_kind::callback) {
+                    _dispatch_callback(*slot, ev, name);
+                } else {
+                    slot->queue->push(ev);
+                }
+
+                return *this;
+            }
+
+            /**
+            ** \brief dispatch a batch of events of the same type.
+            **
+            ** This behaves as dispatching each event in turn, but the event
+            ** type is looked up once per batch:
+            **  - polling events are appended to their queue at once.
+            **  - callbacks taking a std::span<Event const> are called once
+            **    with the whole batch, others once per event. Asynchronous and
+            **    trigger based callbacks get a single task per batch.
+            **
+            ** \tparam Event type of the events to dispatch. It has to be given
+            ** explicitly, e.g. `dispatch_bulk<contact>(contacts)`.
+            ** \param events events to dispatch, in order.
+            */
+            template <typename Event>
+            basic_dispatcher const & dispatch_bulk(std::span<Event const> events) const {
+                char const *name = typeid(Event).name();
+                tracing::scope trace{_trace.get(), name, "dispatch_bulk"};
 
-                if (!_event_kinds.contains(idx)) { return *this; }
+                __impl::event_slot const *slot = Ids::find(_slots, Ids::template id<Event>());
 
-                event_kind k = _event_kinds.at(idx);
+                if (!slot || !slot->kind || events.empty()) { return *this; }
 
-                if (k == event_kind::callback && _callbacks.contains(idx)) {
-                    _dispatch_callback(ev, idx);
-                } else if (auto queue = _queues.find(idx); queue != _queues.end()) {
-                    queue->second.push(ev);
+                if (slot->kind == event_kind::callback) {
+                    _dispatch_callback_bulk(*slot, events, name);
+                } else {
+                    slot->queue->push_bulk(events);
                 }
 
                 return *this;
@@ -267,37 +669,150 @@ namespace hex::events {
             */
             template <typename Event>
             std::optional<Event> poll() {
-                std::type_index idx = typeid(Event);
+                return _polled_queue<Event>().template poll_one<Event>();
+            }
+
+            /**
+            ** \brief poll every pending event, without copying them.
+            **
+            ** \return a span over the events, valid until the next call to
+            ** poll_span for this event type.
+            **
+            ** \see queues::event_queue::poll_span
+            */
+            template <typename Event>
+            std::span<Event> poll_span() {
+                return _polled_queue<Event>().template poll_span<Event>();
+            }
+
+            /**
+            ** \brief record dispatches and callback calls to a tracing sink.
+            **
+            ** \param sink Sink to record to. Passing nullptr disables tracing.
+            */
+            basic_dispatcher & set_trace_sink(std::shared_ptr<tracing::sink> sink) {
+                _trace = std::move(sink);
+
+                return *this;
+            }
+
+            /**
+            ** \brief run asynchronous callbacks on another thread pool.
+            **
+            ** Callbacks already submitted to the previous pool still run, and
+            ** are still waited for by wait_async. Events of a type with
+            ** deliveries still pending follow them on the previous pool, which
+            ** is kept alive until they ran. Passing nullptr makes the
+            ** dispatcher create its own pool again, upon the next asynchronous
+            ** dispatch.
+            **
+            ** \warning Must not be called while other threads dispatch events.
+            */
+            basic_dispatcher & set_thread_pool(std::shared_ptr<thread_pool> pool) {
+                _pool.set(std::move(pool));
+
+                return *this;
+            }
+
+        private:
+            /**
+            ** \brief get the slot of an event type, creating it if needed.
+            **
+            ** The type is also recorded, so that events wrapped in a std::any
+            ** can find it.
+            */
+            template <typename Event>
+            __impl::event_slot &_slot() {
+                std::size_t id = Ids::template id<Event>();
+
+                _any_ids.try_emplace(typeid(Event), id);
+
+                return Ids::get(_slots, id);
+            }
 
-                auto const &kv = _event_kinds.find(idx);
-                if (kv == _event_kinds.end() || kv->second != event_kind::polling) {
+            /**
+            ** \brief find the slot of a type known at runtime only.
+            */
+            __impl::event_slot const *_find(std::type_index idx) const {
+                auto it = _any_ids.find(idx);
+
+                return it == _any_ids.end() ? nullptr : Ids::find(_slots, it->second);
+            }
+
+            /**
+            ** \brief get the queue of a polling event, or abort.
+            */
+            template <typename Event>
+            queues::event_queue &_polled_queue() {
+                __impl::event_slot const *slot = Ids::find(_slots, Ids::template id<Event>());
+
+                if (!slot || slot->kind != event_kind::polling) {
                     std::abort();
-                    return std::nullopt;
                 }
 
-                return _queues.at(idx).poll_one<Event>();
+                return *slot->queue;
             }
 
-        private:
             /**
             ** \brief dispatch a callback-style event.
             */
             template <typename Event>
-            void _dispatch_callback(Event const &ev, std::type_index idx) const {
-                auto const &container = _callbacks.at(idx);
-                callbacks::dispatch_policy pol = _callbacks_policies.at(idx);
-
-                auto lambda = [&, ev]{ container.dispatch(ev); };
+            void _dispatch_callback(__impl::event_slot const &slot, Event const &ev, char const *name) const {
+                callbacks::container &container = *slot.callbacks;
+                callbacks::dispatch_policy pol = slot.policy.value_or(callbacks::dispatch_policy::async);
 
                 if (pol == callbacks::dispatch_policy::sync) {
+                    tracing::scope s{_trace.get(), name, "callbacks"};
                     container.dispatch(ev);
                 } else if (pol == callbacks::dispatch_policy::trigger) {
-                    _pending_callbacks.push_back(std::async(std::launch::deferred, lambda));
+                    container.defer(ev);
+                } else {
+                    _run_async(slot, [c = &container, ev, name, trace = _trace]{
+                        tracing::scope s{trace.get(), name, "callbacks"};
+                        c->dispatch(ev);
+                    });
+                }
+            }
+
+            /**
+            ** \brief dispatch a batch of callback-style events.
+            */
+            template <typename Event>
+            void _dispatch_callback_bulk(__impl::event_slot const &slot, std::span<Event const> events, char const *name) const {
+                callbacks::container &container = *slot.callbacks;
+                callbacks::dispatch_policy pol = slot.policy.value_or(callbacks::dispatch_policy::async);
+
+                if (pol == callbacks::dispatch_policy::sync) {
+                    tracing::scope s{_trace.get(), name, "callbacks"};
+                    container.dispatch_bulk(events);
+                } else if (pol == callbacks::dispatch_policy::trigger) {
+                    container.defer_bulk(events);
                 } else {
-                    _pending_callbacks.push_back(std::async(std::launch::async, lambda));
+                    _run_async_bulk(slot, std::vector<Event>(events.begin(), events.end()), name);
                 }
             }
 
+            /**
+            ** \brief dispatch a batch of events on the thread pool.
+            */
+            template <typename Event>
+            void _run_async_bulk(__impl::event_slot const &slot, std::vector<Event> events, char const *name) const {
+                _run_async(slot, [c = slot.callbacks.get(), evs = std::move(events), name, trace = _trace]{
+                    tracing::scope s{trace.get(), name, "callbacks"};
+                    c->dispatch_bulk(std::span<Event const>{evs});
+                });
+            }
+
+            /**
+            ** \brief run a task on the thread pool, creating it if needed, in
+            ** the lane of an event type, after the tasks of that type posted
+            ** before.
+            */
+            template <typename Task>
+            void _run_async(__impl::event_slot const &slot, Task &&task) const {
+                slot.async->post(_pool.get(), slot.lane, _async.track(std::forward<Task>(task)));
+            }
+
             /**
             ** \brief Declare an event as polling-style event.
             **
@@ -306,32 +821,56 @@ namespace hex::events {
             ** event_queue::clear()
             ** \tparam S A ShrinkPolicy, controlling the behavior of
             ** event_queue::clear().
+            ** \tparam Pr A ProducerPolicy, controlling whether
+            ** event_queue::push can be called from several threads.
+            ** \tparam St A StoragePolicy, controlling whether the queue is
+            ** bounded or coalescing.
             */
             template <typename Event,
                       queues::policies::PendingPolicy P,
-                      queues::policies::ShrinkPolicy S>
-            bool _declare_polling(for_event_t<Event>, P, S) {
-                std::type_index idx = typeid(Event);
-                auto [it, ok] = _event_kinds.try_emplace(idx, event_kind::polling);
-
-                if (ok) {
-                    _queues.try_emplace(idx, for_event<Event>, P{}, S{});
+                      queues::policies::ShrinkPolicy S,
+                      queues::policies::ProducerPolicy Pr,
+                      queues::policies::StoragePolicy St>
+            bool _declare_polling(for_event_t<Event>, P p, S s, Pr pr, St st) {
+                __impl::event_slot &slot = _slot<Event>();
+
+                if (!slot.kind) {
+                    slot.kind = event_kind::polling;
+                    slot.queue = std::make_unique<queues::event_queue>(for_event<Event>, p, s, pr, st);
                 }
 
-                return ok || it->second == event_kind::polling;
+                return slot.kind == event_kind::polling;
             }
 
 
         private:
-            std::unordered_map<std::type_index, event_kind> _event_kinds;
+            /*
+            ** First member: assigning a dispatcher waits for its pending tasks
+            ** before the callbacks they use are replaced.
+            */
+            mutable __impl::async_tracker _async;
 
-            std::unordered_map<std::type_index, callbacks::container> _callbacks;
-            std::unordered_map<std::type_index, callbacks::dispatch_policy> _callbacks_policies;
-            mutable std::unordered_map<std::type_index, std::vector<std::future<void>>> _pending_trigger;
-            mutable std::vector<std::future<void>> _pending_callbacks;
+            typename Ids::slots _slots{};
+            std::unordered_map<std::type_index, std::size_t> _any_ids; /**< Ids of the declared types, for std::any events. */
 
-            mutable std::unordered_map<std::type_index, queues::event_queue> _queues;
+            std::shared_ptr<tracing::sink> _trace;
+            __impl::lazy_pool _pool;
     };
+
+    /**
+    ** \brief Dispatcher for any event type.
+    */
+    using dispatcher = basic_dispatcher<dynamic_ids>;
+
+    /**
+    ** \brief Dispatcher for a closed set of event types, known at compile
+    ** time.
+    **
+    ** Dispatching any other type is a compile-time error, except for events
+    ** wrapped in a std::any, which are ignored.
+    */
+    template <typename... Events>
+    using static_dispatcher = basic_dispatcher<static_ids<Events...>>;
 }
 
 #endif /* end of include guard: hex_mpi_events_dispatcher_hpp_ */
@@ -2,7 +2,12 @@
 #define hex_mpi_events_forward_hpp_
 
 namespace hex::events {
-    class dispatcher;
+    struct dynamic_ids;
+
+    template <class Ids>
+    class basic_dispatcher;
+
+    using dispatcher = basic_dispatcher<dynamic_ids>;
 }
 
 #endif /* end of include guard: hex_mpi_events_forward_hpp_ */
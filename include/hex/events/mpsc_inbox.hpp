@@ -0,0 +1,129 @@
+#ifndef hex_mpi_events_mpsc_inbox_hpp_
+#define hex_mpi_events_mpsc_inbox_hpp_
+
+#include <atomic> // std::atomic, std::memory_order
+#include <span> // std::span
+#include <utility> // std::move
+
+namespace hex::events::queues {
+    /**
+    ** \brief Lock-free multi-producer single-consumer inbox.
+    **
+    ** Producers push events onto an intrusive stack with a single
+    ** compare-and-swap. The consumer takes the whole stack at once, with a
+    ** single exchange, and walks it back to the push order.
+    **
+    ** Since the consumer never pops nodes one by one, the stack is not
+    ** subject to the ABA problem.
+    **
+    ** \tparam Event type of the events.
+    */
+    template <typename Event>
+    class mpsc_inbox {
+        struct node {
+            Event ev;
+            node *next;
+        };
+
+        public:
+            mpsc_inbox() = default;
+
+            mpsc_inbox(mpsc_inbox const &) = delete;
+            mpsc_inbox &operator=(mpsc_inbox const &) = delete;
+
+            ~mpsc_inbox() {
+                _release(_head.exchange(nullptr, std::memory_order_acquire));
+            }
+
+            /**
+            ** \brief push an event. Can be called from any thread.
+            */
+            void push(Event const &ev) {
+                node *n = new node{ev, _head.load(std::memory_order_relaxed)};
+
+                while (!_head.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed))
+                    ;
+            }
+
+            /**
+            ** \brief push a batch of events, with a single compare-and-swap.
+            ** Can be called from any thread.
+            */
+            void push_bulk(std::span<Event const> events) {
+                node *top = nullptr;
+                node *bottom = nullptr;
+
+                try {
+                    for (Event const &ev : events) {
+                        top = new node{ev, top};
+
+                        if (!bottom)
+                            bottom = top;
+                    }
+                } catch (...) {
+                    _release(top);
+                    throw;
+                }
+
+                if (!top)
+                    return;
+
+                bottom->next = _head.load(std::memory_order_relaxed);
+
+                while (!_head.compare_exchange_weak(bottom->next, top, std::memory_order_release, std::memory_order_relaxed))
+                    ;
+            }
+
+            /**
+            ** \brief move every pushed event to out, in push order.
+            **
+            ** \warning Must only be called by the consumer.
+            */
+            template <typename Out>
+            void drain(Out &&out) {
+                node *n = _head.exchange(nullptr, std::memory_order_acquire);
+                node *ordered = nullptr;
+
+                while (n) {
+                    node *next = n->next;
+                    n->next = ordered;
+                    ordered = n;
+                    n = next;
+                }
+
+                try {
+                    while (ordered) {
+                        node *next = ordered->next;
+
+                        out(std::move(ordered->ev));
+                        delete ordered;
+                        ordered = next;
+                    }
+                } catch (...) {
+                    _release(ordered);
+                    throw;
+                }
+            }
+
+            /**
+            ** \brief check whether no event was pushed since the last drain.
+            */
+            bool empty() const noexcept {
+                return _head.load(std::memory_order_relaxed) == nullptr;
+            }
+
+        private:
+            static void _release(node *n) {
+                while (n) {
+                    node *next = n->next;
+                    delete n;
+                    n = next;
+                }
+            }
+
+        private:
+            std::atomic<node *> _head{nullptr};
+    };
+}
+
+#endif /* end of include guard: hex_mpi_events_mpsc_inbox_hpp_ */
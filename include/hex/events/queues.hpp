@@ -4,9 +4,16 @@
 #include <any> // std::any, std::any_cast
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <hex/events/coalescer.hpp>
+#include <hex/events/mpsc_inbox.hpp>
+#include <hex/events/ring_buffer.hpp>
 #include <hex/events/utils.hpp>
 
 #include <hex/utils/concepts.hpp>
@@ -53,6 +60,141 @@ namespace hex::events::queues {
 
         template <typename T>
         concept ShrinkPolicy = one_of<T, shrink_t, no_shrink_t>;
+
+        /**
+        ** \brief If used, events can only be pushed by one thread at a time.
+        */
+        struct single_producer_t {};
+        static constexpr single_producer_t single_producer{};
+
+        /**
+        ** \brief If used, events can be pushed from several threads at once,
+        ** through a lock-free \ref mpsc_inbox "inbox". Polling and clearing
+        ** must still happen on a single thread.
+        */
+        struct mpsc_t {};
+        static constexpr mpsc_t mpsc{};
+
+        template <typename T>
+        concept ProducerPolicy = one_of<T, single_producer_t, mpsc_t>;
+
+        /**
+        ** \brief If used, the queue grows without bound.
+        */
+        struct unbounded_t {};
+        static constexpr unbounded_t unbounded{};
+
+        /**
+        ** \brief If used, the queue is a \ref ring_buffer "ring buffer" of
+        ** fixed capacity.
+        **
+        ** Polled events are removed at once, without moving the pending ones:
+        ** the PendingPolicy then only tells whether clear discards pending
+        ** events, and the ShrinkPolicy is ignored.
+        **
+        ** \see bounded
+        */
+        struct bounded_t {
+            std::size_t capacity;
+            full_policy full;
+        };
+
+        /**
+        ** \name Full policies
+        ** \brief What a bounded queue does with an event pushed while full.
+        */
+        /**@{*/
+        struct drop_oldest_t { static constexpr full_policy value = full_policy::drop_oldest; };
+        static constexpr drop_oldest_t drop_oldest{};
+
+        struct drop_newest_t { static constexpr full_policy value = full_policy::drop_newest; };
+        static constexpr drop_newest_t drop_newest{};
+
+        struct overwrite_t { static constexpr full_policy value = full_policy::overwrite; };
+        static constexpr overwrite_t overwrite{};
+
+        struct block_t { static constexpr full_policy value = full_policy::block; };
+        static constexpr block_t block{};
+
+        template <typename T>
+        concept FullPolicy = one_of<T, drop_oldest_t, drop_newest_t, overwrite_t, block_t>;
+        /**@}*/
+
+        /**
+        ** \brief Build a bounded_t policy, e.g.
+        ** `declare(kind::polling<input>, bounded(256, drop_oldest))`.
+        */
+        template <FullPolicy F>
+        constexpr bounded_t bounded(std::size_t capacity, F) { return {capacity, F::value}; }
+
+        /**
+        ** \brief Reducer of policies::coalesce, keeping the latest event.
+        */
+        struct keep_latest_t {
+            template <typename Event>
+            void operator()(Event &pending, Event const &incoming) const { pending = incoming; }
+        };
+        static constexpr keep_latest_t keep_latest{};
+
+        /**
+        ** \brief If used, an event pushed while an event of the same key is
+        ** pending is merged into it, instead of being appended.
+        **
+        ** Events are kept in the order in which their key was first pushed,
+        ** and a key can be pending again once its event was polled.
+        **
+        ** \see coalesce
+        */
+        template <typename KeyFn, typename Reduce = keep_latest_t>
+        struct coalesce_t {
+            KeyFn key;
+            Reduce reduce;
+        };
+
+        /**
+        ** \brief Build a coalesce_t policy, e.g.
+        ** `declare(kind::polling<moved>, coalesce([](moved const &m) { return m.entity; }))`.
+        **
+        ** \param key callable returning the key of an event, which must be
+        ** hashable.
+        ** \param reduce callable merging an event into the pending one, as
+        ** `reduce(Event &pending, Event const &incoming)`. By default, the
+        ** pending event is replaced.
+        */
+        template <typename KeyFn, typename Reduce = keep_latest_t>
+        coalesce_t<KeyFn, Reduce> coalesce(KeyFn key, Reduce reduce = {}) { return {std::move(key), std::move(reduce)}; }
+
+        template <typename T> struct is_coalesce : std::false_type {};
+        template <typename KeyFn, typename Reduce> struct is_coalesce<coalesce_t<KeyFn, Reduce>> : std::true_type {};
+
+        template <typename T>
+        concept StoragePolicy = one_of<T, unbounded_t, bounded_t> || is_coalesce<T>::value;
+
+        /**
+        ** \brief Any event_queue policy.
+        */
+        template <typename T>
+        concept QueuePolicy = PendingPolicy<T> || ShrinkPolicy<T> || ProducerPolicy<T> || StoragePolicy<T>;
+
+        template <typename T> struct is_pending : std::bool_constant<PendingPolicy<T>> {};
+        template <typename T> struct is_shrink : std::bool_constant<ShrinkPolicy<T>> {};
+        template <typename T> struct is_producer : std::bool_constant<ProducerPolicy<T>> {};
+        template <typename T> struct is_storage : std::bool_constant<StoragePolicy<T>> {};
+
+        /**
+        ** \brief Pick, among policies, the one matching Is, or def.
+        */
+        template <template <typename> class Is, typename Default>
+        constexpr Default pick(Default def) { return def; }
+
+        template <template <typename> class Is, typename Default, typename P, typename... Policies>
+        constexpr auto pick(Default def, P p, Policies... policies) {
+            if constexpr (Is<P>::value) {
+                return p;
+            } else {
+                return pick<Is>(def, policies...);
+            }
+        }
     }
 
     /**
@@ -61,13 +203,21 @@ namespace hex::events::queues {
     ** This type holds all queued events for a single event type.
     **
     ** Events can be \ref event_queue::push "pushed" to the end of the queue,
-    ** or polled, using poll_one or poll_all. Once polled, an event is
+    ** or polled, using poll_one, poll_all or poll_span. Once polled, an event is
     ** considered handled, and cannot be retrieved. It will be deleted when
     ** event_queue::clear will be called.
     **
     ** By default, the event_queue::clear remove all events from the event
     ** queue. This behavior can be changed by passing
     ** clear_policies::keep_pending to the queue constructor.
+    **
+    ** By default, a single thread may push at a time. With policies::mpsc,
+    ** pushes go to a lock-free inbox, which is moved to the queue by the
+    ** consumer before polling or clearing.
+    **
+    ** By default, the queue grows without bound. With policies::bounded, it
+    ** is a ring buffer of fixed capacity. With policies::coalesce, it holds
+    ** at most one pending event per key.
     */
     class event_queue {
         /**
@@ -76,6 +226,14 @@ namespace hex::events::queues {
         template <typename Event>
         using container_impl = std::vector<Event>;
 
+        /**
+        ** \brief internal container implementation, with policies::bounded.
+        **
+        ** Shared, since std::any requires copyable types.
+        */
+        template <typename Event>
+        using ring_impl = std::shared_ptr<ring_buffer<Event>>;
+
 
         /**
         ** \name Helper functions
@@ -109,12 +267,28 @@ namespace hex::events::queues {
         */
         template <typename Event, policies::PendingPolicy P, policies::ShrinkPolicy S>
         static void _clear_impl(event_queue &queue) {
+            if (queue._bounded) {
+                if constexpr (!std::is_same_v<P, policies::keep_pending_t>) {
+                    queue._ring<Event>().clear();
+                }
+
+                return;
+            }
+
+            queue._collect<Event>();
+
             std::vector<Event> &vec = _cast_queue<Event>(queue._queue);
 
             if constexpr (!std::is_same_v<P, policies::keep_pending_t>) {
                 vec.clear();
+
+                if (queue._coalescer)
+                    queue._coalescing<Event>().reset();
             } else {
                 vec.erase(vec.begin(), vec.begin() + queue._next);
+
+                if (queue._coalescer)
+                    queue._coalescing<Event>().reindex(vec, 0);
             }
 
             if constexpr (std::is_same_v<S, policies::shrink_t>) {
@@ -150,12 +324,46 @@ namespace hex::events::queues {
         ** function will additionally shrink the underlying container.
         */
         template <typename Event, policies::PendingPolicy P, policies::ShrinkPolicy S>
-        event_queue(for_event_t<Event>, P, S) :
-            _queue(std::in_place_type<container_impl<Event>>),
+        event_queue(for_event_t<Event> e, P p, S s) :
+            event_queue(e, p, s, policies::single_producer)
+        {}
+
+        template <typename Event, policies::PendingPolicy P, policies::ShrinkPolicy S, policies::ProducerPolicy Pr>
+        event_queue(for_event_t<Event> e, P p, S s, Pr pr) :
+            event_queue(e, p, s, pr, policies::unbounded)
+        {}
+
+        template <typename Event,
+                  policies::PendingPolicy P,
+                  policies::ShrinkPolicy S,
+                  policies::ProducerPolicy Pr,
+                  policies::StoragePolicy St>
+        event_queue(for_event_t<Event>, P, S, Pr, St st) :
+            _front(std::in_place_type<container_impl<Event>>),
             _next(0),
             _clear(_clear_impl<Event, P, S>),
             _push_any(_push_any_impl<Event>)
-        {}
+        {
+            static_assert(!(std::is_same_v<Pr, policies::mpsc_t> && std::is_same_v<St, policies::bounded_t>),
+                    "A bounded event queue cannot have several producers.");
+
+            if constexpr (std::is_same_v<St, policies::bounded_t>) {
+                _queue = std::make_shared<ring_buffer<Event>>(st.capacity, st.full);
+                _bounded = true;
+            } else {
+                _queue.emplace<container_impl<Event>>();
+            }
+
+            if constexpr (policies::is_coalesce<St>::value) {
+                using keyed = keyed_coalescer<Event, decltype(st.key), decltype(st.reduce)>;
+
+                _coalescer = std::shared_ptr<coalescer<Event>>(std::make_shared<keyed>(std::move(st.key), std::move(st.reduce)));
+            }
+
+            if constexpr (std::is_same_v<Pr, policies::mpsc_t>) {
+                _inbox = std::make_shared<mpsc_inbox<Event>>();
+            }
+        }
         /**@}*/
 
         /**
@@ -186,6 +394,11 @@ namespace hex::events::queues {
         */
         template <typename Event>
         std::optional<Event> poll_one() {
+            if (_bounded)
+                return _ring<Event>().pop();
+
+            _collect<Event>();
+
             std::vector<Event> &vec = _cast_queue<Event>(_queue);
 
             if (vec.size() <= _next)
@@ -204,29 +417,143 @@ namespace hex::events::queues {
         */
         template <typename Event>
         std::vector<Event> poll_all() {
-            std::vector<Event> &vec = _cast_queue<Event>(_queue);
             std::vector<Event> ret{};
 
+            if (_bounded) {
+                auto &ring = _ring<Event>();
+
+                ret.reserve(ring.size());
+                while (auto ev = ring.pop())
+                    ret.push_back(std::move(*ev));
+
+                return ret;
+            }
+
+            _collect<Event>();
+
+            std::vector<Event> &vec = _cast_queue<Event>(_queue);
+
             std::move(vec.begin() + _next, vec.end(), std::back_inserter(ret));
 
             vec.clear();
             _next = 0;
 
+            if (_coalescer)
+                _coalescing<Event>().reset();
+
             return ret;
         }
 
+        /**
+        ** \brief return all event in this queue, without copying them.
+        **
+        ** The queue is double-buffered: the pending events are swapped into
+        ** a front buffer, and pushes go on to the emptied back buffer. Both
+        ** buffers keep their capacity, so that polling every frame ends up
+        ** allocating nothing.
+        **
+        ** \tparam Event queue events.
+        **
+        ** \return Return a span over the pending events. It is valid until
+        ** the next call to poll_span.
+        */
+        template <typename Event>
+        std::span<Event> poll_span() {
+            std::vector<Event> &front = _cast_queue<Event>(_front);
+
+            front.clear();
+
+            if (_bounded) {
+                auto &ring = _ring<Event>();
+
+                while (auto ev = ring.pop())
+                    front.push_back(std::move(*ev));
+
+                return front;
+            }
+
+            _collect<Event>();
+
+            std::vector<Event> &vec = _cast_queue<Event>(_queue);
+            std::size_t next = std::exchange(_next, 0);
+
+            front.swap(vec);
+
+            if (_coalescer)
+                _coalescing<Event>().reset();
+
+            return std::span<Event>{front}.subspan(next);
+        }
+
         /**
         ** \brief append an event to the queue.
         **
         ** \tparam Event type of the pushed event.
         **
         ** \param ev event to append to the queue.
+        **
+        ** \note If the queue was constructed with policies::mpsc, this can be
+        ** called from several threads at once.
+        **
+        ** \note If the queue was constructed with policies::bounded, and is
+        ** full, the event is handled according to the full policy.
+        **
+        ** \note If the queue was constructed with policies::coalesce, and an
+        ** event of the same key is pending, the event is merged into it.
         */
         template <typename Event>
         void push(Event const &ev) {
+            if (_bounded) {
+                _ring<Event>().push(ev);
+                return;
+            }
+
+            if (_inbox) {
+                static_cast<mpsc_inbox<Event> *>(_inbox.get())->push(ev);
+                return;
+            }
+
+            _append(_cast_queue<Event>(_queue), ev);
+        }
+
+        /**
+        ** \brief append a batch of events to the queue.
+        **
+        ** Unbounded queues grow at most once, and copy the whole batch at
+        ** once. With policies::mpsc, the batch is published with a single
+        ** atomic operation. With policies::coalesce, events are merged one by
+        ** one.
+        **
+        ** \tparam Event type of the pushed events.
+        **
+        ** \param events events to append to the queue, in order.
+        */
+        template <typename Event>
+        void push_bulk(std::span<Event const> events) {
+            if (_bounded) {
+                auto &ring = _ring<Event>();
+
+                for (Event const &ev : events)
+                    ring.push(ev);
+
+                return;
+            }
+
+            if (_inbox) {
+                static_cast<mpsc_inbox<Event> *>(_inbox.get())->push_bulk(events);
+                return;
+            }
+
             std::vector<Event> &vec = _cast_queue<Event>(_queue);
 
-            vec.push_back(ev);
+            if (_coalescer) {
+                for (Event const &ev : events)
+                    _coalescing<Event>().push(vec, _next, ev);
+
+                return;
+            }
+
+            vec.insert(vec.end(), events.begin(), events.end());
         }
 
         void push(std::any const &ev) {
@@ -246,11 +573,52 @@ namespace hex::events::queues {
             _clear(*this);
         }
 
+        private:
+            template <typename Event>
+            ring_buffer<Event> &_ring() {
+                return *std::any_cast<ring_impl<Event> &>(_queue);
+            }
+
+            template <typename Event>
+            coalescer<Event> &_coalescing() {
+                return *static_cast<coalescer<Event> *>(_coalescer.get());
+            }
+
+            /**
+            ** \brief append an event to an unbounded queue, merging it with
+            ** policies::coalesce.
+            */
+            template <typename Event, typename E>
+            void _append(std::vector<Event> &vec, E &&ev) {
+                if (_coalescer)
+                    _coalescing<Event>().push(vec, _next, ev);
+                else
+                    vec.push_back(std::forward<E>(ev));
+            }
+
+            /**
+            ** \brief move the events pushed to the inbox, if any, to the
+            ** queue.
+            */
+            template <typename Event>
+            void _collect() {
+                if (!_inbox)
+                    return;
+
+                std::vector<Event> &vec = _cast_queue<Event>(_queue);
+
+                static_cast<mpsc_inbox<Event> *>(_inbox.get())->drain([&](Event &&ev) { _append(vec, std::move(ev)); });
+            }
+
         private:
             std::any _queue;
+            std::any _front; /**< container_impl<Event>, holding the events returned by poll_span. */
             std::size_t _next;
             clear_f * _clear;
             push_any_f* _push_any;
+            std::shared_ptr<void> _inbox; /**< mpsc_inbox<Event>, with policies::mpsc. */
+            std::shared_ptr<void> _coalescer; /**< coalescer<Event>, with policies::coalesce. */
+            bool _bounded = false; /**< Whether _queue holds a ring_impl<Event>. */
     };
 }
 
@@ -0,0 +1,133 @@
+#ifndef hex_mpi_events_ring_buffer_hpp_
+#define hex_mpi_events_ring_buffer_hpp_
+
+#include <atomic> // std::atomic, std::memory_order
+#include <cstddef> // std::size_t
+#include <optional> // std::optional
+#include <stdexcept> // std::invalid_argument
+#include <thread> // std::this_thread::yield
+#include <utility> // std::move
+#include <vector> // std::vector
+
+namespace hex::events::queues {
+    /**
+    ** \brief What a ring_buffer does with an event pushed while it is full.
+    */
+    enum class full_policy {
+        drop_oldest, /**< The oldest pending event is discarded. */
+        drop_newest, /**< The pushed event is discarded. */
+        overwrite, /**< The pushed event replaces the most recent pending one. */
+        block, /**< The producer yields until the consumer polls an event. */
+    };
+
+    /**
+    ** \brief Fixed-capacity circular event buffer.
+    **
+    ** Events are constructed in place in a preallocated array of slots, and
+    ** polling one only moves the read position: memory is never moved nor
+    ** allocated after construction.
+    **
+    ** With full_policy::drop_newest or full_policy::block, one producer
+    ** thread and one consumer thread can use the buffer at once. With the
+    ** other policies, a full buffer is modified on the producer side, and the
+    ** buffer must be used by a single thread at a time.
+    **
+    ** \tparam Event type of the events.
+    */
+    template <typename Event>
+    class ring_buffer {
+        public:
+            /**
+            ** \throw std::invalid_argument is thrown if capacity is zero.
+            */
+            ring_buffer(std::size_t capacity, full_policy full) : _slots(capacity), _full(full) {
+                if (capacity == 0)
+                    throw std::invalid_argument("ring_buffer error: capacity must not be zero.");
+            }
+
+            ring_buffer(ring_buffer const &) = delete;
+            ring_buffer &operator=(ring_buffer const &) = delete;
+
+            std::size_t capacity() const noexcept { return _slots.size(); }
+
+            std::size_t size() const noexcept {
+                return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+            }
+
+            /**
+            ** \brief push an event, applying the full policy if there is no
+            ** room left.
+            **
+            ** \return false if the event was dropped.
+            */
+            bool push(Event const &ev) {
+                std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+                if (tail - _head.load(std::memory_order_acquire) == capacity()) {
+                    switch (_full) {
+                        case full_policy::drop_newest:
+                            return false;
+                        case full_policy::overwrite:
+                            _slot(tail - 1) = ev;
+                            return true;
+                        case full_policy::drop_oldest:
+                            _pop();
+                            break;
+                        case full_policy::block:
+                            while (tail - _head.load(std::memory_order_acquire) == capacity())
+                                std::this_thread::yield();
+                            break;
+                    }
+                }
+
+                _slot(tail).emplace(ev);
+                _tail.store(tail + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+            ** \brief retrieve the oldest pending event, if any.
+            */
+            std::optional<Event> pop() {
+                std::size_t head = _head.load(std::memory_order_relaxed);
+
+                if (head == _tail.load(std::memory_order_acquire))
+                    return std::nullopt;
+
+                std::optional<Event> ev = std::move(_slot(head));
+                _pop();
+
+                return ev;
+            }
+
+            /**
+            ** \brief discard every pending event.
+            */
+            void clear() {
+                while (size() != 0)
+                    _pop();
+            }
+
+        private:
+            std::optional<Event> &_slot(std::size_t pos) noexcept {
+                return _slots[pos % _slots.size()];
+            }
+
+            void _pop() {
+                std::size_t head = _head.load(std::memory_order_relaxed);
+
+                _slot(head).reset();
+                _head.store(head + 1, std::memory_order_release);
+            }
+
+        private:
+            std::vector<std::optional<Event>> _slots;
+            full_policy _full;
+
+            std::atomic<std::size_t> _head{0}; /**< Position of the next event to poll, written by the consumer. */
+            std::atomic<std::size_t> _tail{0}; /**< Position of the next event to push, written by the producer. */
+    };
+}
+
+#endif /* end of include guard: hex_mpi_events_ring_buffer_hpp_ */
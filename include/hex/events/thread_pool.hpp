@@ -0,0 +1,166 @@
+#ifndef hex_mpi_events_thread_pool_hpp_
+#define hex_mpi_events_thread_pool_hpp_
+
+#include <algorithm> // std::max
+#include <array> // std::array
+#include <condition_variable> // std::condition_variable
+#include <deque> // std::deque
+#include <functional> // std::function
+#include <memory> // std::shared_ptr, std::make_shared
+#include <mutex> // std::mutex, std::lock_guard, std::unique_lock
+#include <thread> // std::thread
+#include <utility> // std::move
+#include <vector> // std::vector
+
+namespace hex::events {
+    /**
+    ** \brief Priority lane of a task, or of an event type.
+    */
+    enum class priority {
+        high, /**< Latency-critical, e.g. player input. */
+        normal,
+        low, /**< Background work, e.g. telemetry. */
+    };
+
+    /**
+    ** \brief Fixed-size pool of worker threads.
+    **
+    ** Workers are started upon construction, and wait for tasks on shared
+    ** queues, one per \ref priority "priority lane". An idle worker always
+    ** takes the oldest task of the highest non-empty lane. Workers are joined
+    ** upon destruction, once every submitted task has run.
+    **
+    ** A pool may be destroyed by one of its own tasks, e.g. when the task held
+    ** its last std::shared_ptr: that worker is then detached instead of
+    ** joined, and keeps running the remaining tasks with the others.
+    **
+    ** A pool can be shared between several \ref dispatcher "dispatchers".
+    */
+    class thread_pool {
+        public:
+            /**
+            ** \brief start the workers.
+            **
+            ** \param workers number of worker threads. Defaults to the number
+            ** of hardware threads, and is at least one.
+            **
+            ** If a worker cannot be started, the ones already started are
+            ** joined before the exception is rethrown.
+            */
+            explicit thread_pool(std::size_t workers = std::thread::hardware_concurrency()) : _state(std::make_shared<state>()) {
+                workers = std::max<std::size_t>(workers, 1);
+
+                try {
+                    _workers.reserve(workers);
+
+                    for (std::size_t i = 0; i < workers; ++i)
+                        _workers.emplace_back([st = _state]{ _run(*st); });
+                } catch (...) {
+                    _stop();
+                    throw;
+                }
+            }
+
+            thread_pool(thread_pool const &) = delete;
+            thread_pool &operator=(thread_pool const &) = delete;
+
+            ~thread_pool() { _stop(); }
+
+            /**
+            ** \brief number of worker threads.
+            */
+            std::size_t size() const noexcept {
+                return _workers.size();
+            }
+
+            /**
+            ** \brief queue a task, to be run by the first idle worker.
+            **
+            ** \param task task to run.
+            ** \param lane priority lane of the task.
+            **
+            ** \warning The task must not throw.
+            */
+            void submit(std::function<void()> task, priority lane = priority::normal) {
+                {
+                    std::lock_guard lock{_state->mutex};
+                    _state->lanes[static_cast<std::size_t>(lane)].push_back(std::move(task));
+                }
+
+                _state->ready.notify_one();
+            }
+
+        private:
+            /**
+            ** \brief Queues shared by the workers.
+            **
+            ** Each worker holds it, so that a worker detached by the pool's
+            ** destructor can still use it.
+            */
+            struct state {
+                std::mutex mutex;
+                std::condition_variable ready;
+                std::array<std::deque<std::function<void()>>, 3> lanes; /**< Indexed by priority. */
+                bool stopping = false;
+            };
+
+            /**
+            ** \brief let the workers run the remaining tasks, then join them.
+            **
+            ** The calling thread is detached instead if it is a worker.
+            */
+            void _stop() noexcept {
+                {
+                    std::lock_guard lock{_state->mutex};
+                    _state->stopping = true;
+                }
+
+                _state->ready.notify_all();
+
+                for (auto &w : _workers) {
+                    if (w.get_id() == std::this_thread::get_id())
+                        w.detach();
+                    else
+                        w.join();
+                }
+            }
+
+            static void _run(state &st) {
+                for (;;) {
+                    std::function<void()> task;
+
+                    {
+                        std::unique_lock lock{st.mutex};
+                        std::deque<std::function<void()>> *lane = nullptr;
+
+                        st.ready.wait(lock, [&st, &lane]{ return (lane = _next_lane(st)) || st.stopping; });
+
+                        if (!lane)
+                            return;
+
+                        task = std::move(lane->front());
+                        lane->pop_front();
+                    }
+
+                    task();
+                }
+            }
+
+            /**
+            ** \brief highest priority lane holding a task, if any.
+            */
+            static std::deque<std::function<void()>> *_next_lane(state &st) noexcept {
+                for (auto &lane : st.lanes)
+                    if (!lane.empty())
+                        return &lane;
+
+                return nullptr;
+            }
+
+        private:
+            std::shared_ptr<state> _state;
+            std::vector<std::thread> _workers;
+    };
+}
+
+#endif /* end of include guard: hex_mpi_events_thread_pool_hpp_ */
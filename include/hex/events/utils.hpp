@@ -1,6 +1,9 @@
 #ifndef hex_mpi_events_utils_hpp_
 #define hex_mpi_events_utils_hpp_
 
+#include <atomic>
+#include <cstddef>
+
 namespace hex::events {
     /**
     ** \brief Tag type used to help deducing function template parameter.
@@ -13,6 +16,27 @@ namespace hex::events {
     */
     template <typename Event>
     static constexpr for_event_t<Event> for_event {};
+
+    namespace __impl {
+        inline std::size_t next_event_id() noexcept {
+            static std::atomic<std::size_t> next{0};
+
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+    ** \brief Dense id of an event type.
+    **
+    ** Ids are assigned on first use, starting from zero, and are the same in
+    ** every dispatcher of the program.
+    */
+    template <typename Event>
+    std::size_t event_id() noexcept {
+        static std::size_t const id = __impl::next_event_id();
+
+        return id;
+    }
 }
 
 #endif /* end of include guard: hex_mpi_events_utils_hpp_ */
@@ -0,0 +1,25 @@
+/**
+** \file schedule_cycle.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 10:05
+** \date Last update: 2026-10-18 10:05
+*/
+
+#ifndef SCHEDULE_CYCLE_HPP_
+#define SCHEDULE_CYCLE_HPP_
+
+#include <stdexcept>
+
+namespace hex::exceptions {
+    class schedule_cycle : public std::logic_error {
+        public:
+            virtual ~schedule_cycle() {}
+
+            using std::logic_error::logic_error;
+            using std::logic_error::operator=;
+            using std::logic_error::what;
+    };
+}
+
+#endif /* end of include guard: SCHEDULE_CYCLE_HPP_ */
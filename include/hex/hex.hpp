@@ -3,19 +3,25 @@
 **
 ** \author Phantomas <phantomas@phantomas.xyz>
 ** \date Created on: 2021-12-05 16:33
-** \date Last update: 2021-12-29 19:23
+** \date Last update: 2026-10-18 17:20
 */
 
 #ifndef HEX_HPP__
 #define HEX_HPP__
 
+#include "hex/containers/group.hpp"
+#include "hex/containers/packed_array.hpp"
 #include "hex/containers/sparse_array.hpp"
 #include "hex/components_registry.hpp"
 #include "hex/entity_manager.hpp"
 #include "hex/system_registry.hpp"
 #include "hex/context.hpp"
+#include "hex/iterators/merge_join.hpp"
 #include "hex/iterators/zip.hpp"
+#include "hex/query/persistent.hpp"
+#include "hex/query/view.hpp"
 #include "hex/utilities/indexer.hpp"
+#include "hex/tracing/sink.hpp"
 
 /**
 ** \brief Hex main namespace.
@@ -24,12 +30,30 @@ namespace hex {
     /// Re-expose sparse_array as hex::sparse_array.
     using containers::sparse_array;
 
+    /// Re-expose packed_array as hex::packed_array.
+    using containers::packed_array;
+
+    /// Re-expose group as hex::group.
+    using containers::group;
+
     /// Re-expose zip as hex::zip.
     using iterators::zip;
 
     /// Re-expose izip as hex::izip.
     using iterators::izip;
 
+    /// Re-expose merge_join as hex::merge_join.
+    using iterators::merge_join;
+
+    /// Re-expose imerge_join as hex::imerge_join.
+    using iterators::imerge_join;
+
+    /// Re-expose view as hex::view.
+    using query::view;
+
+    /// Re-expose without as hex::without.
+    using query::without;
+
     /// Re-expose index as hex::indexer.
     using utility::indexer;
 }
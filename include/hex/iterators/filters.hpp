@@ -0,0 +1,88 @@
+/**
+** \file filters.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 15:05
+** \date Last update: 2026-10-18 15:05
+*/
+
+#ifndef iterators_filters_hpp__
+#define iterators_filters_hpp__
+
+#include <cstddef> // std::size_t
+#include <limits> // std::numeric_limits
+#include <utility> // std::declval
+
+namespace hex::iterators {
+    /**
+    ** \brief Position of a filter in its container, as stored by a zip_iterator.
+    */
+    template <class Container>
+    struct filter_cursor {
+        using iter_t = decltype(std::declval<Container &>().begin());
+
+        iter_t begin;
+        std::size_t size;
+
+        /**
+        ** \brief Check whether the container has an element at idx.
+        */
+        [[nodiscard]] bool has(std::size_t idx) const { return idx < size && begin[idx]; }
+    };
+
+    /**
+    ** \brief Pseudo-container excluding, from a zip, the indices where a container has an element.
+    **
+    ** It does not limit the zip's size, and yields nothing.
+    **
+    ** \see without
+    */
+    template <class Container>
+    class without_t {
+        public:
+            using cursor = filter_cursor<Container>;
+
+            explicit without_t(Container &c) noexcept : _c(&c) {}
+
+            std::size_t size() const noexcept { return std::numeric_limits<std::size_t>::max(); }
+            cursor begin() const { return {_c->begin(), _c->size()}; }
+
+        private:
+            Container *_c;
+    };
+
+    /**
+    ** \brief Pseudo-container yielding, in a zip, a pointer to a container element, or nullptr if there is none.
+    **
+    ** It does not limit the zip's size, nor skips any index.
+    **
+    ** \see maybe
+    */
+    template <class Container>
+    class maybe_t {
+        public:
+            using cursor = filter_cursor<Container>;
+
+            explicit maybe_t(Container &c) noexcept : _c(&c) {}
+
+            std::size_t size() const noexcept { return std::numeric_limits<std::size_t>::max(); }
+            cursor begin() const { return {_c->begin(), _c->size()}; }
+
+        private:
+            Container *_c;
+    };
+
+    /**
+    ** \brief Skip the indices where c has an element, e.g. `hex::zip{pos, vel, hex::iterators::without(frozen)}`.
+    */
+    template <class Container>
+    without_t<Container> without(Container &c) noexcept { return without_t<Container>{c}; }
+
+    /**
+    ** \brief Yield a pointer to the element of c, or nullptr, without skipping any index.
+    */
+    template <class Container>
+    maybe_t<Container> maybe(Container &c) noexcept { return maybe_t<Container>{c}; }
+}
+
+#endif /* end of include guard: iterators_filters_hpp__ */
@@ -0,0 +1,247 @@
+/**
+** \file merge_join.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 17:20
+** \date Last update: 2026-10-18 17:20
+*/
+
+#ifndef iterators_merge_join_hpp__
+#define iterators_merge_join_hpp__
+
+#include <algorithm> // std::lower_bound, std::min
+#include <array> // std::array
+#include <cassert> // assert
+#include <cstddef> // std::ptrdiff_t, std::size_t
+#include <iterator> // std::input_iterator_tag
+#include <ranges> // std::ranges::view_base, std::ranges::enable_borrowed_range
+#include <tuple> // std::tuple, std::tuple_cat
+#include <type_traits> // std::conditional_t, std::remove_reference_t
+#include <utility> // std::declval, std::index_sequence_for
+
+namespace hex::iterators {
+    /**
+    ** \brief Position of the first id not below target, in the sorted ids [from, size).
+    **
+    ** Probes from + 1, from + 2, from + 4, ... then binary searches the last gap. Matching ids close to from cost a
+    ** couple of comparisons, and far ones a logarithmic number, so joining a small set with a huge one only touches a
+    ** few of the huge set's ids.
+    */
+    inline std::size_t gallop(std::size_t const *ids, std::size_t size, std::size_t from, std::size_t target) noexcept {
+        if (from >= size || ids[from] >= target)
+            return from;
+
+        std::size_t lo = from;
+        std::size_t step = 1;
+
+        while (from + step < size && ids[from + step] < target) {
+            lo = from + step;
+            step *= 2;
+        }
+
+        std::size_t hi = std::min(from + step, size);
+
+        return std::lower_bound(ids + lo + 1, ids + hi, target) - ids;
+    }
+
+    /**
+    ** \brief Sentinel marking the end of any merge_join.
+    */
+    struct merge_join_sentinel {};
+
+    /**
+    ** \cond Internals
+    */
+    namespace __impl {
+        template <class Container>
+        struct merge_column {
+            using values_t = decltype(std::declval<Container &>().values().data());
+            using values = std::tuple<decltype(*std::declval<values_t>())>;
+
+            std::size_t const *ids = nullptr;
+            std::size_t size = 0;
+            values_t data = nullptr;
+
+            merge_column() = default;
+            explicit merge_column(Container &c) : ids(c.ids().data()), size(c.ids().size()), data(c.values().data()) {
+                assert(c.index_ordered() && "merge_join needs containers in index order: call sort() first.");
+            }
+        };
+    }
+    /**
+    ** \endcond
+    */
+
+    /**
+    ** \brief Iterate over the indices present in every one of several packed containers.
+    **
+    ** Each container exposes its sorted indices through ids(), and its elements, in the same order, through values().
+    ** The iterator keeps a position in each id list, and merges them: each list in turn gallops to the largest id seen
+    ** so far, until they all agree on one. Elements are then read at the current positions, without any lookup.
+    **
+    ** \tparam Indexed Whether the matching index is yielded first.
+    ** \tparam Containers Types of the containers, e.g. containers::packed_array.
+    */
+    template <bool Indexed, class... Containers>
+    class merge_join_iterator {
+        static_assert(sizeof...(Containers) != 0, "Cannot join no containers.");
+
+        using columns = std::tuple<__impl::merge_column<Containers>...>;
+        using index_values = std::conditional_t<Indexed, std::tuple<std::size_t>, std::tuple<>>;
+
+        public:
+            using value_type = decltype(std::tuple_cat(std::declval<index_values>(), std::declval<typename __impl::merge_column<Containers>::values>()...));
+            using reference = value_type;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::input_iterator_tag;
+            using iterator_concept = std::input_iterator_tag;
+
+        public:
+            merge_join_iterator() = default;
+            explicit merge_join_iterator(columns const &cols) : _cols(cols) { _seek(0, _idx_seq); }
+
+            merge_join_iterator &operator++() {
+                ++std::get<0>(_pos);
+                _seek(0, _idx_seq);
+
+                return *this;
+            }
+
+            merge_join_iterator operator++(int) { auto r = *this; ++(*this); return r; }
+
+            value_type operator*() const { return _to_value(_idx_seq); }
+
+            /**
+            ** \brief Index of the current element.
+            **
+            ** \pre The iterator must not be past the end.
+            */
+            [[nodiscard]] std::size_t index() const noexcept { return std::get<0>(_cols).ids[std::get<0>(_pos)]; }
+
+            friend bool operator==(merge_join_iterator const &lhs, merge_join_iterator const &rhs) noexcept {
+                return lhs._done == rhs._done && (lhs._done || lhs._pos == rhs._pos);
+            }
+
+            friend bool operator==(merge_join_iterator const &it, merge_join_sentinel) noexcept { return it._done; }
+
+        private:
+            template <std::size_t... Idx>
+            void _seek(std::size_t target, std::index_sequence<Idx...>) {
+                bool aligned = false;
+
+                while (!_done && !aligned) {
+                    aligned = true;
+                    ((_done || (_done = !_align<Idx>(target, aligned))), ...);
+                }
+            }
+
+            /*
+            ** Gallop container I to target. Raise target, and clear aligned, if the container's next id is past it.
+            */
+            template <std::size_t I>
+            bool _align(std::size_t &target, bool &aligned) noexcept {
+                auto const &col = std::get<I>(_cols);
+                auto &pos = std::get<I>(_pos);
+
+                pos = gallop(col.ids, col.size, pos, target);
+
+                if (pos == col.size)
+                    return false;
+
+                if (col.ids[pos] != target) {
+                    aligned = aligned && I == 0;
+                    target = col.ids[pos];
+                }
+
+                return true;
+            }
+
+            template <std::size_t... Idx>
+            value_type _to_value(std::index_sequence<Idx...>) const {
+                if constexpr (Indexed)
+                    return value_type{index(), std::get<Idx>(_cols).data[std::get<Idx>(_pos)]...};
+                else
+                    return value_type{std::get<Idx>(_cols).data[std::get<Idx>(_pos)]...};
+            }
+
+        private:
+            columns _cols;
+            std::array<std::size_t, sizeof...(Containers)> _pos{};
+            bool _done = false;
+
+            static constexpr std::index_sequence_for<Containers...> _idx_seq{};
+    };
+
+    /**
+    ** \cond Internals
+    */
+    namespace __impl {
+        template <bool Indexed, class... Containers>
+        class merge_join_base : public std::ranges::view_base {
+            public:
+                using iterator = merge_join_iterator<Indexed, Containers...>;
+
+                merge_join_base() = default;
+                explicit merge_join_base(Containers &... cs) : _cols{merge_column<Containers>{cs}...} {}
+
+                iterator begin() const { return iterator{_cols}; }
+                merge_join_sentinel end() const noexcept { return {}; }
+
+            private:
+                std::tuple<merge_column<Containers>...> _cols;
+        };
+    }
+    /**
+    ** \endcond
+    */
+
+    /**
+    ** \brief Pseudo-container iterating over the indices present in every one of several packed containers.
+    **
+    ** It is the counterpart of zip for containers::packed_array: `for (auto [pos, vel] : hex::merge_join{pos, vel})`.
+    ** Instead of probing each container at each candidate index, it merges their sorted id lists, galloping over the
+    ** ids missing from the others. Joining containers of very different sizes thus costs about the size of the smallest.
+    **
+    ** Like a zip, it is a std::ranges::view referring to the containers, and is invalidated by any insertion or erasure.
+    **
+    ** \pre Every container must be in index order, e.g. not reordered by packed_array::sort or a group. This is
+    ** asserted upon construction.
+    **
+    ** \tparam Containers Types of the containers, possibly const.
+    */
+    template <class... Containers>
+    class merge_join : public __impl::merge_join_base<false, Containers...> {
+        public:
+            merge_join(Containers &... cs) : __impl::merge_join_base<false, Containers...>{cs...} {}
+    };
+
+    /**
+    ** \related merge_join
+    */
+    template <class... Containers>
+    merge_join(Containers &...) -> merge_join<Containers...>;
+
+    /**
+    ** \brief Specialized version of merge_join, that provide index.
+    */
+    template <class... Containers>
+    class imerge_join : public __impl::merge_join_base<true, Containers...> {
+        public:
+            imerge_join(Containers &... cs) : __impl::merge_join_base<true, Containers...>{cs...} {}
+    };
+
+    /**
+    ** \related imerge_join
+    */
+    template <class... Containers>
+    imerge_join(Containers &...) -> imerge_join<Containers...>;
+}
+
+template <class... Containers>
+inline constexpr bool std::ranges::enable_borrowed_range<hex::iterators::merge_join<Containers...>> = true;
+
+template <class... Containers>
+inline constexpr bool std::ranges::enable_borrowed_range<hex::iterators::imerge_join<Containers...>> = true;
+
+#endif /* end of include guard: iterators_merge_join_hpp__ */
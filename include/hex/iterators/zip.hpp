@@ -3,52 +3,252 @@
 **
 ** \author Phantomas <phantomas@phantomas.xyz>
 ** \date Created on: 2021-12-09 11:08
-** \date Last update: 2021-12-29 20:24
+** \date Last update: 2026-10-18 14:40
 */
 
 #ifndef iterators_zip_hpp__
 #define iterators_zip_hpp__
 
+#include <algorithm> // std::min, std::max
+#include <concepts> // std::convertible_to
 #include <cstddef> // std::ptrdiff_t, std::size_t
 #include <iterator> // std::input_iterator_tag
-#include <tuple> // std::tuple
-#include <type_traits> // std::conjunction
-#include <utility> // std::declval, std::forward, swap
-
+#include <limits> // std::numeric_limits
+#include <memory> // std::addressof
+#include <ranges> // std::ranges::view_base, std::ranges::enable_borrowed_range
+#include <span> // std::span
+#include <tuple> // std::tuple, std::tuple_cat
+#include <type_traits> // std::remove_reference_t
+#include <utility> // std::declval, std::forward, std::move, swap
+#include <vector> // std::vector
+
+#include "hex/iterators/filters.hpp"
 #include "hex/meta/type_traits.hpp"
 #include "hex/utilities/indexer.hpp"
+#include "hex/utils/prefetch.hpp"
 
 namespace hex::iterators {
     /**
     ** \cond Internals
     */
     namespace __impl {
+        /*
+        ** Containers keeping a presence bitmap, like containers::sparse_array, let the join skip their empty slots
+        ** by words instead of one by one.
+        */
+        template <class Container>
+        concept tracks_presence = requires (Container const &c, std::size_t idx) {
+            { c.next_present(idx, idx) } -> std::convertible_to<std::size_t>;
+            { c.present_count() } -> std::convertible_to<std::size_t>;
+        };
+
+        /*
+        ** Position of a container tracking presence, as stored by a zip_iterator.
+        */
+        template <class Container>
+        struct presence_cursor {
+            using iter_t = decltype(std::declval<Container &>().begin());
+
+            iter_t begin;
+            Container const *container = nullptr;
+        };
+
+        /*
+        ** What a zip_iterator stores for each container: a cursor for containers tracking presence, and their begin
+        ** iterator otherwise.
+        */
+        template <class Container>
+        auto zip_begin(Container &c) {
+            if constexpr (tracks_presence<Container>)
+                return presence_cursor<Container>{c.begin(), std::addressof(c)};
+            else
+                return c.begin();
+        }
+
+        /*
+        ** Each helper tells how a zip_iterator walks one of its containers:
+        **  - next_set: first index, from idx and below max, where the container does not exclude the entity.
+        **  - to_value: tuple of what the container yields at idx, possibly empty.
+        **  - prefetch: hint the cache about the container's slot at idx, which is below the zip's size.
+        **  - present: number of elements the container may yield, used to pick the container leading the join.
+        */
         template <class Container>
         struct iterator_helper {
             using iter_t = decltype(std::declval<Container>().begin());
             using value_type = decltype(std::declval<typename iter_t::reference>().value()) &;
-            static value_type to_value(typename iter_t::reference &v) { return v.value(); }
+            using values = std::tuple<value_type>;
+
+            static_assert(meta::is_optional_v<typename iter_t::value_type>, "zip_iterator are designed to work with container of optional value.");
+
+            static std::size_t next_set(iter_t const &it, std::size_t idx, std::size_t max) {
+                while (idx < max && !it[idx])
+                    ++idx;
+
+                return idx;
+            }
+
+            static values to_value(iter_t const &it, std::size_t idx) { return {it[idx].value()}; }
+
+            static void prefetch(iter_t const &it, std::size_t idx) noexcept { HEX_PREFETCH(std::addressof(it[idx])); }
+
+            static std::size_t present(iter_t const &) noexcept { return std::numeric_limits<std::size_t>::max(); }
+
+            static std::size_t run_end(iter_t const &it, std::size_t idx, std::size_t limit) {
+                while (idx < limit && it[idx])
+                    ++idx;
+
+                return idx;
+            }
+
+            static auto spans(iter_t const &it, std::size_t idx, std::size_t n) {
+                return std::tuple{std::span{std::addressof(it[idx]), n}};
+            }
         };
 
+        template <class Container>
+            requires tracks_presence<Container>
+            struct iterator_helper<Container> {
+                using iter_t = presence_cursor<Container>;
+                using value_type = decltype(std::declval<typename iter_t::iter_t::reference>().value()) &;
+                using values = std::tuple<value_type>;
+
+                static std::size_t next_set(iter_t const &c, std::size_t idx, std::size_t max) {
+                    // The bitmap may mark empty slots, which are checked and skipped one at a time.
+                    while ((idx = c.container->next_present(idx, max)) < max && !c.begin[idx])
+                        ++idx;
+
+                    return idx;
+                }
+
+                static values to_value(iter_t const &c, std::size_t idx) { return {c.begin[idx].value()}; }
+
+                static void prefetch(iter_t const &c, std::size_t idx) noexcept { HEX_PREFETCH(std::addressof(c.begin[idx])); }
+
+                static std::size_t present(iter_t const &c) noexcept { return c.container->present_count(); }
+
+                static std::size_t run_end(iter_t const &c, std::size_t idx, std::size_t limit) {
+                    while (idx < limit && c.begin[idx])
+                        ++idx;
+
+                    return idx;
+                }
+
+                static auto spans(iter_t const &c, std::size_t idx, std::size_t n) {
+                    return std::tuple{std::span{std::addressof(c.begin[idx]), n}};
+                }
+            };
+
         template <>
             struct iterator_helper<utility::indexer_t> {
                 using iter_t = decltype(utility::indexer.begin());
                 using value_type = utility::indexer_iterator::reference;
+                using values = std::tuple<value_type>;
+
+                static std::size_t next_set(iter_t const &, std::size_t idx, std::size_t) noexcept { return idx; }
+                static values to_value(iter_t const &, std::size_t idx) noexcept { return {idx}; }
+
+                static void prefetch(iter_t const &, std::size_t) noexcept {}
+                static std::size_t present(iter_t const &) noexcept { return std::numeric_limits<std::size_t>::max(); }
+
+                static std::size_t run_end(iter_t const &, std::size_t, std::size_t limit) noexcept { return limit; }
+                static std::tuple<> spans(iter_t const &, std::size_t, std::size_t) noexcept { return {}; }
+            };
+
+        template <class Container>
+            struct iterator_helper<without_t<Container>> {
+                using iter_t = typename without_t<Container>::cursor;
+                using values = std::tuple<>;
+
+                static std::size_t next_set(iter_t const &c, std::size_t idx, std::size_t max) {
+                    while (idx < max && c.has(idx))
+                        ++idx;
+
+                    return idx;
+                }
+
+                static values to_value(iter_t const &, std::size_t) noexcept { return {}; }
+
+                static void prefetch(iter_t const &c, std::size_t idx) noexcept {
+                    if (idx < c.size) HEX_PREFETCH(std::addressof(c.begin[idx]));
+                }
+
+                static std::size_t present(iter_t const &) noexcept { return std::numeric_limits<std::size_t>::max(); }
+
+                static std::size_t run_end(iter_t const &c, std::size_t idx, std::size_t limit) {
+                    while (idx < limit && !c.has(idx))
+                        ++idx;
+
+                    return idx;
+                }
+
+                static std::tuple<> spans(iter_t const &, std::size_t, std::size_t) noexcept { return {}; }
+            };
+
+        template <class Container>
+            struct iterator_helper<maybe_t<Container>> {
+                using iter_t = typename maybe_t<Container>::cursor;
+                using value_type = std::remove_reference_t<decltype(*std::declval<typename iter_t::iter_t>()[0])> *;
+                using values = std::tuple<value_type>;
+
+                static std::size_t next_set(iter_t const &, std::size_t idx, std::size_t) noexcept { return idx; }
+                static values to_value(iter_t const &c, std::size_t idx) { return {c.has(idx) ? &*c.begin[idx] : nullptr}; }
+
+                static void prefetch(iter_t const &c, std::size_t idx) noexcept {
+                    if (idx < c.size) HEX_PREFETCH(std::addressof(c.begin[idx]));
+                }
+
+                static std::size_t present(iter_t const &) noexcept { return std::numeric_limits<std::size_t>::max(); }
+
+                static std::size_t run_end(iter_t const &, std::size_t, std::size_t limit) {
+                    static_assert(!sizeof(Container *), "maybe_t cannot be used with block iteration.");
+                    return limit;
+                }
 
-                static value_type to_value(value_type v) { return v; }
+                static std::tuple<> spans(iter_t const &, std::size_t, std::size_t) { return {}; }
             };
+
+        template <class Container>
+        struct zip_param { using type = Container &; };
+
+        template <class Container>
+        struct zip_param<without_t<Container>> { using type = without_t<Container>; };
+
+        template <class Container>
+        struct zip_param<maybe_t<Container>> { using type = maybe_t<Container>; };
+
+        template <class Container>
+        using zip_param_t = typename zip_param<Container>::type;
     }
     /**
     ** \endcond
     */
 
+    /**
+    ** \brief Sentinel marking the end of any zip.
+    **
+    ** Comparing a zip_iterator to it only compares the iterator's index to its upper bound.
+    */
+    struct zip_sentinel {};
+
     /**
     ** \brief Iterate over several containers at once.
     **
     ** This iterator enable the use of range-based for loop or standard algorithm.
     **
-    ** It work by storing iterators over specific containers, increasing these all at the same time, and skipping the ones where the optional evaluate to false.
-    ** Where dereferenced, the iterator return a tuple of reference, as if the tuple was created by dereferencing every iterator it stores.
+    ** It work by storing iterators to the beginning of specific containers, and an index, skipping the indices where one of the optional evaluate to false.
+    ** Where dereferenced, the iterator return a tuple of reference, as if the tuple was created by dereferencing every container at the current index.
+    **
+    ** Skipping is done as a leapfrog join: each container in turn scans forward, on its own, to its next present element,
+    ** until they all agree on an index. A gap in one container is thus skipped in a single tight loop over that
+    ** container, instead of checking every container at every index.
+    **
+    ** Containers keeping a presence bitmap, like sparse_array, skip their gaps by words of 64 slots, and the one with
+    ** the fewest elements leads the join: the others are only checked at its candidate indices. Joining a large
+    ** container with a small one then costs about one step per element of the small one, plus one per word of its
+    ** bitmap.
+    **
+    ** Containers wrapped in without_t take part in the join the other way around, skipping runs of present elements,
+    ** and yield nothing. Containers wrapped in maybe_t never skip an index, and yield a pointer that may be null.
     **
     ** \tparam Containers Type of the container to iterate over.
     */
@@ -62,27 +262,18 @@ namespace hex::iterators {
 
             static_assert(sizeof...(Containers) != 0, "Cannot zip no containers.");
 
-            static_assert(std::conjunction_v<
-                    std::disjunction<
-                        meta::is_optional<typename iter_t<Containers>::value_type>,
-                        std::is_same<Containers, utility::indexer_t>
-                    >...
-            >, "zip_iterator are designed to work with container of optional value.");
-
-            template <typename Container>
-            using inner_t = typename __impl::iterator_helper<Container>::value_type;
-
-            using value_type = std::tuple<inner_t<Containers>...>;
+            using value_type = decltype(std::tuple_cat(std::declval<typename __impl::iterator_helper<Containers>::values>()...));
             using reference = value_type;
             using pointer = void;
             using difference_type = std::ptrdiff_t;
             using iterator_category = std::input_iterator_tag;
+            using iterator_concept = std::input_iterator_tag;
 
         public:
-            zip_iterator(std::tuple<iter_t<Containers>...> const &it_tuple, std::size_t max, void *from = nullptr) : _state(it_tuple), _max(max), _idx{0}, _from{from} {
-                while (_idx != _max && !_all_set(_idx_seq)) {
-                    ++(*this);
-                }
+            zip_iterator() = default;
+            zip_iterator(std::tuple<iter_t<Containers>...> const &it_tuple, std::size_t max, void const *from = nullptr, std::size_t first = 0, std::size_t prefetch = 0)
+                : _state(it_tuple), _max(max), _idx{first < max ? first : max}, _prefetch{prefetch}, _from{from}, _lead{_find_lead(_idx_seq)} {
+                _seek(_idx_seq);
             }
             zip_iterator(zip_iterator const &oth) = default;
             zip_iterator(zip_iterator &&) noexcept = default;
@@ -93,50 +284,130 @@ namespace hex::iterators {
             zip_iterator &operator=(zip_iterator &&) noexcept = default;
 
             zip_iterator &operator++() { _increment(_idx_seq); return *this; }
+
+            /**
+            ** \brief Index of the current element.
+            */
+            [[nodiscard]] std::size_t index() const noexcept { return _idx; }
+
+            /**
+            ** \brief Number of consecutive matching indices, starting from the current one.
+            **
+            ** \pre The iterator must not be past the end.
+            */
+            [[nodiscard]] std::size_t run_length() const { return _run_end(_idx_seq) - _idx; }
+
+            /**
+            ** \brief Spans over each container's elements in [index(), index() + n).
+            **
+            ** \pre Every index in that range must match, e.g. n must not exceed run_length().
+            */
+            [[nodiscard]] auto spans(std::size_t n) const { return _spans(n, _idx_seq); }
+
+            /**
+            ** \brief Move n indices forward, then on to the next matching index.
+            */
+            zip_iterator &skip(std::size_t n) {
+                _idx = n < _max - _idx ? _idx + n : _max;
+                _seek(_idx_seq);
+
+                return *this;
+            }
+
             zip_iterator operator++(int) { auto r = *this; _increment(_idx_seq); return r; }
 
-            value_type operator*() { return _to_value(_idx_seq); }
-            value_type operator->() { return _to_value(_idx_seq); }
+            value_type operator*() const { return _to_value(_idx_seq); }
+            value_type operator->() const { return _to_value(_idx_seq); }
 
             friend bool operator==(zip_iterator const &lhs, zip_iterator const &rhs) { return (lhs._from == rhs._from && lhs._idx == rhs._idx) || (lhs._idx == lhs._max && rhs._idx == rhs._max); }
             friend bool operator!=(zip_iterator const &lhs, zip_iterator const &rhs) { return !(lhs == rhs); }
 
+            friend bool operator==(zip_iterator const &it, zip_sentinel) noexcept { return it._idx == it._max; }
+
             void swap(zip_iterator &oth) noexcept(std::is_nothrow_swappable_v<iter_tuple> &&
                                                   std::is_nothrow_swappable_v<std::size_t> &&
-                                                  std::is_nothrow_swappable_v<void *>) {
+                                                  std::is_nothrow_swappable_v<void const *>) {
                 using std::swap;
                 swap(_state, oth._state);
                 swap(_max, oth._max);
                 swap(_idx, oth._idx);
+                swap(_prefetch, oth._prefetch);
                 swap(_from, oth._from);
+                swap(_lead, oth._lead);
             }
         private:
             template <size_t... Idx>
-            bool _all_set(std::index_sequence<Idx...>) {
-                return (true && ... &&
-                        (std::is_same_v<utility::indexer_iterator, std::tuple_element_t<Idx, iter_tuple>> || *std::get<Idx>(_state)));
+            void _increment(std::index_sequence<Idx...> seq) {
+                if (_idx != _max) {
+                    ++_idx;
+                    _seek(seq);
+
+                    if (_prefetch && _max - _idx > _prefetch)
+                        (__impl::iterator_helper<std::tuple_element_t<Idx, cont_tuple>>::prefetch(std::get<Idx>(_state), _idx + _prefetch), ...);
+                }
             }
 
+            /**
+            ** \brief Move to the first index, starting from the current one, where every container is set.
+            */
             template <size_t... Idx>
-            void _increment(std::index_sequence<Idx...>) {
-                if (_idx != _max) {
-                    do {
-                        ++_idx;
-                        (++(std::get<Idx>(_state)), ...);
-                    } while (_idx != _max && !_all_set(_idx_seq));
-                }
+            void _seek(std::index_sequence<Idx...>) {
+                std::size_t prev;
+
+                do {
+                    prev = _idx;
+                    ((Idx == _lead ? (_idx = _next_set<Idx>(_idx)) : _idx), ...);
+                    ((_idx = _next_set<Idx>(_idx)), ...);
+                } while (_idx != prev);
             }
 
+            /**
+            ** \brief Index of the container with the fewest elements, which leads the join.
+            */
             template <size_t... Idx>
-            value_type _to_value(std::index_sequence<Idx...>) {
-                return {__impl::iterator_helper<std::tuple_element_t<Idx, cont_tuple>>::to_value(*std::get<Idx>(_state))...};
+            std::size_t _find_lead(std::index_sequence<Idx...>) const {
+                std::size_t lead = 0;
+                std::size_t fewest = std::numeric_limits<std::size_t>::max();
+
+                ((__impl::iterator_helper<std::tuple_element_t<Idx, cont_tuple>>::present(std::get<Idx>(_state)) < fewest
+                    ? (fewest = __impl::iterator_helper<std::tuple_element_t<Idx, cont_tuple>>::present(std::get<Idx>(_state)), lead = Idx)
+                    : lead), ...);
+                return lead;
+            }
+
+            /**
+            ** \brief Next index, starting from idx, where the I-th container does not exclude the entity.
+            */
+            template <size_t I>
+            std::size_t _next_set(std::size_t idx) const {
+                return __impl::iterator_helper<std::tuple_element_t<I, cont_tuple>>::next_set(std::get<I>(_state), idx, _max);
+            }
+
+            template <size_t... Idx>
+            std::size_t _run_end(std::index_sequence<Idx...>) const {
+                std::size_t end = _max;
+
+                ((end = __impl::iterator_helper<std::tuple_element_t<Idx, cont_tuple>>::run_end(std::get<Idx>(_state), _idx, end)), ...);
+                return end;
+            }
+
+            template <size_t... Idx>
+            auto _spans(std::size_t n, std::index_sequence<Idx...>) const {
+                return std::tuple_cat(__impl::iterator_helper<std::tuple_element_t<Idx, cont_tuple>>::spans(std::get<Idx>(_state), _idx, n)...);
+            }
+
+            template <size_t... Idx>
+            value_type _to_value(std::index_sequence<Idx...>) const {
+                return std::tuple_cat(__impl::iterator_helper<std::tuple_element_t<Idx, cont_tuple>>::to_value(std::get<Idx>(_state), _idx)...);
             }
         private:
-            iter_tuple _state;
-            std::size_t _max;
-            std::size_t _idx;
+            iter_tuple _state; /**< Iterators to the beginning of each container. */
+            std::size_t _max = 0;
+            std::size_t _idx = 0;
+            std::size_t _prefetch = 0; /**< Distance, in indices, of the slots to prefetch. Zero disables prefetching. */
 
-            void *_from;
+            void const *_from = nullptr;
+            std::size_t _lead = 0; /**< Index of the container leading the join. */
 
             static constexpr std::index_sequence_for<Containers...> _idx_seq{};
     };
@@ -148,16 +419,89 @@ namespace hex::iterators {
     void swap(zip_iterator<Containers...> &lhs, zip_iterator<Containers...> &rhs) noexcept(noexcept(lhs.swap(rhs)))
     { lhs.swap(rhs); }
 
+    /**
+    ** \brief Run of consecutive indices where every zipped container matches.
+    **
+    ** \tparam Spans Tuple of spans, one per zipped container yielding components.
+    */
+    template <class Spans>
+    struct zip_block {
+        std::size_t first; /**< First index of the run. */
+        std::size_t size; /**< Length of the run. */
+        Spans spans; /**< Spans over the optionals of each container, all of which hold a value. */
+    };
+
+    /**
+    ** \brief Iterate over a zip by blocks of consecutive matching indices.
+    */
+    template <class... Containers>
+    class zip_block_iterator {
+        public:
+            using value_type = zip_block<decltype(std::declval<zip_iterator<Containers...> const &>().spans(0))>;
+            using reference = value_type;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::input_iterator_tag;
+            using iterator_concept = std::input_iterator_tag;
+
+            zip_block_iterator() = default;
+            explicit zip_block_iterator(zip_iterator<Containers...> it) : _it(std::move(it)), _size(_block_size()) {}
+
+            value_type operator*() const { return {_it.index(), _size, _it.spans(_size)}; }
+
+            zip_block_iterator &operator++() {
+                _it.skip(_size);
+                _size = _block_size();
+
+                return *this;
+            }
+
+            zip_block_iterator operator++(int) { auto r = *this; ++(*this); return r; }
+
+            friend bool operator==(zip_block_iterator const &it, zip_sentinel s) noexcept { return it._it == s; }
+
+        private:
+            std::size_t _block_size() const { return _it == zip_sentinel{} ? 0 : _it.run_length(); }
+
+        private:
+            zip_iterator<Containers...> _it;
+            std::size_t _size = 0;
+    };
+
+    /**
+    ** \brief Range of the blocks of a zip.
+    **
+    ** \see zip::blocks
+    */
+    template <class... Containers>
+    class zip_blocks : public std::ranges::view_base {
+        public:
+            zip_blocks() = default;
+            explicit zip_blocks(zip_iterator<Containers...> first) : _first(std::move(first)) {}
+
+            zip_block_iterator<Containers...> begin() const { return zip_block_iterator<Containers...>{_first}; }
+            zip_sentinel end() const noexcept { return {}; }
+
+        private:
+            zip_iterator<Containers...> _first;
+    };
+
     /**
     ** \brief Pseudo-container that enable multi-array iteration.
     **
     ** The purpose of this class is to enable the use of ranged-base for loop on several components at once.
     ** The iterator produced skip indices for which at least one of the optional evaluate to false.
     **
+    ** A zip is a std::ranges::view: it only refers to the containers, and can be piped into standard range adaptors.
+    ** Its end is a zip_sentinel, so the loop exit test is a single index comparison.
+    **
+    ** A zip covers a range of indices, and can be cut into independent zips over disjoint sub-ranges with subrange or
+    ** split, for instance to hand chunks to worker threads. Iteration over a sub-range starts right at its first index.
+    **
     ** \tparam Containers Types of the container we want to iterate upon.
     */
     template <class... Containers>
-    class zip {
+    class zip : public std::ranges::view_base {
         public:
             using iterator = zip_iterator<Containers...>;
             using iter_tuple = typename iterator::iter_tuple;
@@ -168,36 +512,116 @@ namespace hex::iterators {
             **
             ** \param containers Parameter pack containing each container to iterate uppon.
             */
-            zip(Containers &... containers) : _size(_compute_size(containers...)), _begin(containers.begin()...), _end(_compute_end(_size, containers...)) {}
+            zip(__impl::zip_param_t<Containers>... containers) : _first(0), _size(_compute_size(containers...)), _begin(__impl::zip_begin(containers)...) {}
             zip(zip const &) = default;
             zip(zip &&) noexcept = default;
 
+            zip &operator=(zip const &) = default;
+            zip &operator=(zip &&) noexcept = default;
+
             /**
             ** \brief Get a zip_iterator to the beginning of this container.
             */
-            iterator begin() { return iterator{_begin, _size, this}; }
+            iterator begin() const { return iterator{_begin, _size, this, _first, _prefetch}; }
 
             /**
-            ** \brief Get a zip_iterator to the end of this container.
+            ** \brief Get the sentinel marking the end of this container.
             */
-            iterator end() { return iterator{_end, 0}; }
+            zip_sentinel end() const noexcept { return {}; }
 
-        private:
-            static size_t _compute_size(Containers const &... containers) {
-                return std::min({containers.size()...});
+            /**
+            ** \brief Iterate over runs of consecutive matching indices instead of single indices.
+            **
+            ** Each zip_block holds the first index of a run, its length, and a std::span per container over the run.
+            ** Kernels can then loop over plain spans, which compilers can vectorize.
+            ** Containers wrapped in without_t yield no span; maybe_t cannot be used.
+            */
+            zip_blocks<Containers...> blocks() const { return zip_blocks<Containers...>{begin()}; }
+
+            /**
+            ** \brief Get a copy of this zip whose iterators prefetch the containers' slots distance indices ahead.
+            **
+            ** Each time an iterator lands on a matching index, the slots at that index plus distance are prefetched in
+            ** every container, hiding part of the memory latency of sparse joins over large containers.
+            ** A distance of zero, the default, disables prefetching.
+            **
+            ** The prefetched index may be a hole: finding the next matching indices instead would scan the containers a
+            ** second time, which costs more than the prefetches it saves.
+            **
+            ** \note The best distance depends on the data layout and the loop body: it should be measured, e.g. with the
+            ** Hex_zip_prefetch_bench benchmark. Joins over entities with random ids gain the most, from distances of
+            ** about a hundred indices; joins filtering out most indices gain little, as they are bound by the scan.
+            */
+            [[nodiscard]] zip prefetch(size_type distance) const {
+                zip z{*this};
+
+                z._prefetch = distance;
+                return z;
             }
 
-            static iter_tuple _compute_end(size_t size, Containers &... containers) {
-                size_t sz = _compute_size(containers...);
+            /**
+            ** \brief First index covered by this zip.
+            */
+            [[nodiscard]] size_type first_index() const noexcept { return _first; }
+
+            /**
+            ** \brief Index past the last one covered by this zip.
+            */
+            [[nodiscard]] size_type last_index() const noexcept { return _size; }
+
+            /**
+            ** \brief Get a zip over the indices in [first, last), clamped to the ones covered by this zip.
+            */
+            [[nodiscard]] zip subrange(size_type first, size_type last) const {
+                zip sub{*this};
+
+                sub._first = std::min(std::max(first, _first), _size);
+                sub._size = std::max(std::min(last, _size), sub._first);
+
+                return sub;
+            }
+
+            /**
+            ** \brief Split this zip into at most n zips over contiguous, disjoint index ranges of similar length.
+            **
+            ** Ranges are returned in order, and together cover every index covered by this zip.
+            */
+            [[nodiscard]] std::vector<zip> split(size_type n) const {
+                std::vector<zip> parts;
+                size_type count = _size - _first;
+
+                if (n == 0)
+                    return parts;
+
+                size_type chunk = count / n + (count % n != 0);
+
+                if (chunk == 0)
+                    chunk = 1;
+
+                parts.reserve(std::min(n, count ? count : 1));
+                for (size_type first = _first; first < _size || parts.empty(); first += chunk)
+                    parts.push_back(subrange(first, first + chunk));
+
+                return parts;
+            }
 
-                return std::tuple{(containers.begin() + sz)...};
+        private:
+            static size_t _compute_size(Containers const &... containers) {
+                return std::min({containers.size()...});
             }
         private:
+            size_t _first;
             size_t _size;
+            size_t _prefetch = 0;
             iter_tuple _begin;
-            iter_tuple _end;
     };
 
+    /**
+    ** \related zip
+    */
+    template <class... Containers>
+    zip(Containers &&...) -> zip<std::remove_reference_t<Containers>...>;
+
     /**
     ** \brief Specialized version of zip, that provide index.
     **
@@ -208,13 +632,72 @@ namespace hex::iterators {
             using base_t = zip<utility::indexer_t, Containers...>;
 
             public:
-                izip(Containers &... cs) : base_t{const_cast<utility::indexer_t &>(utility::indexer), cs...} {}
+                izip(__impl::zip_param_t<Containers>... cs) : base_t{const_cast<utility::indexer_t &>(utility::indexer), cs...} {}
                 using base_t::base_t;
 
+                /**
+                ** \copydoc zip::subrange
+                */
+                [[nodiscard]] izip subrange(std::size_t first, std::size_t last) const { return izip{base_t::subrange(first, last)}; }
+
+                /**
+                ** \copydoc zip::prefetch
+                */
+                [[nodiscard]] izip prefetch(std::size_t distance) const { return izip{base_t::prefetch(distance)}; }
+
+                /**
+                ** \copydoc zip::split
+                */
+                [[nodiscard]] std::vector<izip> split(std::size_t n) const {
+                    std::vector<izip> parts;
+
+                    for (auto &part : base_t::split(n))
+                        parts.push_back(izip{std::move(part)});
+
+                    return parts;
+                }
+
                 using base_t::operator=;
                 using base_t::begin;
                 using base_t::end;
+
+            private:
+                explicit izip(base_t &&base) : base_t(std::move(base)) {}
         };
+
+    /**
+    ** \related izip
+    */
+    template <class... Containers>
+    izip(Containers &&...) -> izip<std::remove_reference_t<Containers>...>;
 }
 
+namespace hex::views {
+    /**
+    ** \brief Range adaptor building a zip over containers, e.g. `hex::views::zip(pos, vel) | std::views::take(10)`.
+    */
+    inline constexpr struct {
+        template <class... Containers>
+        iterators::zip<std::remove_reference_t<Containers>...> operator()(Containers &&... containers) const {
+            return iterators::zip<std::remove_reference_t<Containers>...>{std::forward<Containers>(containers)...};
+        }
+    } zip{};
+
+    /**
+    ** \brief Range adaptor building an izip over containers.
+    */
+    inline constexpr struct {
+        template <class... Containers>
+        iterators::izip<std::remove_reference_t<Containers>...> operator()(Containers &&... containers) const {
+            return iterators::izip<std::remove_reference_t<Containers>...>{std::forward<Containers>(containers)...};
+        }
+    } izip{};
+}
+
+template <class... Containers>
+inline constexpr bool std::ranges::enable_borrowed_range<hex::iterators::zip<Containers...>> = true;
+
+template <class... Containers>
+inline constexpr bool std::ranges::enable_borrowed_range<hex::iterators::izip<Containers...>> = true;
+
 #endif /* end of include guard: iterators_zip_hpp__ */
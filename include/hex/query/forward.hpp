@@ -0,0 +1,48 @@
+/**
+** \file forward.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 15:40
+** \date Last update: 2026-10-18 15:40
+*/
+
+#ifndef query_forward_hpp__
+#define query_forward_hpp__
+
+#include <cstddef> // std::size_t
+#include <typeindex> // std::type_index
+#include <vector> // std::vector
+
+namespace hex {
+    class components_registry;
+}
+
+namespace hex::query {
+    template <typename...> class view;
+    template <typename...> class persistent;
+
+    /**
+    ** \brief Interface of the objects notified by a components_registry when a component is added or removed.
+    */
+    class listener {
+        public:
+            virtual ~listener() = default;
+
+            /**
+            ** \brief Component types whose changes must be notified.
+            */
+            [[nodiscard]] virtual std::vector<std::type_index> watched() const = 0;
+
+            /**
+            ** \brief Rebuild the listener's state from scratch.
+            */
+            virtual void rebuild(components_registry &cr) = 0;
+
+            /**
+            ** \brief Called after a watched component of the entity at idx was added or removed.
+            */
+            virtual void update(components_registry &cr, std::size_t idx) = 0;
+    };
+}
+
+#endif /* end of include guard: query_forward_hpp__ */
@@ -0,0 +1,128 @@
+/**
+** \file persistent.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 15:42
+** \date Last update: 2026-10-18 15:42
+*/
+
+#ifndef query_persistent_hpp__
+#define query_persistent_hpp__
+
+#include <cstddef> // std::size_t
+#include <tuple> // std::tuple, std::tuple_cat, std::apply
+#include <typeindex> // std::type_index
+#include <vector> // std::vector
+
+#include "hex/components_registry.hpp"
+#include "hex/query/forward.hpp"
+#include "hex/query/view.hpp"
+
+namespace hex::query {
+    /**
+    ** \brief Query whose matching entities are kept up to date by the components registry.
+    **
+    ** A persistent query is created with components_registry::register_query, and uses the same parameters as a view.
+    ** It keeps a dense list of the matching entity indices: when a watched component is inserted, emplaced or removed
+    ** through the registry (or the entity_manager), only the membership of that entity is checked again.
+    ** Walking a persistent query is thus a walk over its dense list, whatever the number of entities in the world.
+    **
+    ** \warning Changes made directly to a container, bypassing the registry, are not tracked. Call
+    ** components_registry::refresh_queries afterward.
+    **
+    ** \tparam Ts Included, read-only, and excluded components.
+    */
+    template <typename... Ts>
+    class persistent : public listener {
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        public:
+            persistent() = default;
+            persistent(persistent const &) = delete;
+            persistent &operator=(persistent const &) = delete;
+
+            /**
+            ** \brief Indices of the matching entities, in no particular order.
+            */
+            [[nodiscard]] std::vector<std::size_t> const &entities() const noexcept { return _dense; }
+
+            [[nodiscard]] std::size_t size() const noexcept { return _dense.size(); }
+            [[nodiscard]] bool empty() const noexcept { return _dense.empty(); }
+
+            /**
+            ** \brief Check whether the entity at idx matches.
+            */
+            [[nodiscard]] bool contains(std::size_t idx) const noexcept { return idx < _sparse.size() && _sparse[idx] != npos; }
+
+            /**
+            ** \brief Call f with the index and components of every matching entity.
+            */
+            template <class F>
+            void each(components_registry &cr, F &&f) const {
+                view<Ts...> v{cr};
+
+                for (std::size_t idx : _dense)
+                    std::apply(f, std::tuple_cat(std::tuple<std::size_t>{idx}, v[idx]));
+            }
+
+            [[nodiscard]] std::vector<std::type_index> watched() const override {
+                return {typeid(typename __impl::term<Ts>::component)...};
+            }
+
+            void rebuild(components_registry &cr) override {
+                _dense.clear();
+                _sparse.clear();
+
+                view<Ts...>{cr}.each([this](std::size_t idx, auto &&...) { _insert(idx); });
+            }
+
+            void update(components_registry &cr, std::size_t idx) override {
+                bool match = (true && ... && _match<Ts>(cr, idx));
+
+                if (match && !contains(idx))
+                    _insert(idx);
+                else if (!match && contains(idx))
+                    _erase(idx);
+            }
+
+        private:
+            template <typename T>
+            static bool _match(components_registry &cr, std::size_t idx) {
+                using term_t = __impl::term<T>;
+                using component = typename term_t::component;
+
+                if constexpr (term_t::excluded) {
+                    if (!cr.has<component>())
+                        return true;
+                }
+
+                auto const &cont = cr.get<component>();
+                bool present = idx < cont.size() && cont[idx];
+
+                return present != term_t::excluded;
+            }
+
+            void _insert(std::size_t idx) {
+                if (idx >= _sparse.size())
+                    _sparse.resize(idx + 1, npos);
+
+                _sparse[idx] = _dense.size();
+                _dense.push_back(idx);
+            }
+
+            void _erase(std::size_t idx) {
+                std::size_t pos = _sparse[idx];
+
+                _dense[pos] = _dense.back();
+                _sparse[_dense[pos]] = pos;
+                _dense.pop_back();
+                _sparse[idx] = npos;
+            }
+
+        private:
+            std::vector<std::size_t> _dense; /**< Matching entities. */
+            std::vector<std::size_t> _sparse; /**< Position of each entity in _dense, or npos. */
+    };
+}
+
+#endif /* end of include guard: query_persistent_hpp__ */
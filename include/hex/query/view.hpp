@@ -0,0 +1,268 @@
+/**
+** \file view.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 13:24
+** \date Last update: 2026-10-18 13:24
+*/
+
+#ifndef query_view_hpp__
+#define query_view_hpp__
+
+#include <algorithm> // std::min
+#include <cstddef> // std::ptrdiff_t, std::size_t
+#include <iterator> // std::forward_iterator_tag
+#include <limits> // std::numeric_limits
+#include <optional> // std::optional
+#include <tuple> // std::tuple, std::tuple_cat, std::apply
+#include <typeindex> // std::type_index
+#include <type_traits> // std::conditional_t, std::is_const_v, std::remove_const_t, std::disjunction, std::false_type, std::true_type
+#include <utility> // std::index_sequence_for, std::forward
+
+#include "hex/components_registry.hpp"
+#include "hex/scheduling/access.hpp"
+
+namespace hex::query {
+    /**
+    ** \brief Exclusion marker.
+    **
+    ** When used as a view parameter, entities having a Component are skipped. The component is never accessed.
+    **
+    ** \tparam Component Type of the component to exclude.
+    */
+    template <typename Component>
+    struct without {};
+
+    /**
+    ** \cond Internals
+    */
+    namespace __impl {
+        template <typename T>
+        struct term {
+            static constexpr bool excluded = false;
+            static constexpr bool read_only = std::is_const_v<T>;
+
+            using component = std::remove_const_t<T>;
+            using pointer = std::conditional_t<read_only, std::optional<component> const *, std::optional<component> *>;
+            using values = std::tuple<T &>;
+        };
+
+        template <typename T>
+        struct term<without<T>> {
+            static constexpr bool excluded = true;
+            static constexpr bool read_only = true;
+
+            using component = std::remove_const_t<T>;
+            using pointer = std::optional<component> const *;
+            using values = std::tuple<>;
+        };
+
+        template <typename T>
+        struct column {
+            typename term<T>::pointer data = nullptr;
+            std::size_t size = 0;
+        };
+    }
+    /**
+    ** \endcond
+    */
+
+    /**
+    ** \brief Typed query over the components registry.
+    **
+    ** A view selects the entities having every included component, and none of the excluded ones. Each parameter is
+    ** either:
+    **  - `T`: the component is included, and yielded as a mutable reference.
+    **  - `T const`: the component is included, and yielded as a const reference.
+    **  - `without<T>`: the component is excluded, and not yielded.
+    **
+    ** The iteration bound (the smallest included container size) is computed once, upon construction, and the loop
+    ** checks every container through raw pointers, without resizing any of them.
+    **
+    ** Views can be used as system parameter: they are then built from the registry before each call, the system is not
+    ** called when empty() is true, and the components they use are recorded as the system's access.
+    **
+    ** A view holds pointers to the containers: it is invalidated by anything invalidating their iterators.
+    **
+    ** \tparam Ts Included, read-only, and excluded components.
+    */
+    template <typename... Ts>
+    class view {
+        static_assert((!__impl::term<Ts>::excluded || ...), "A view needs at least one included component.");
+
+        public:
+            /**
+            ** \brief Tuple of references to the included components.
+            */
+            using value_type = decltype(std::tuple_cat(std::declval<typename __impl::term<Ts>::values>()...));
+
+            class iterator {
+                public:
+                    using value_type = view::value_type;
+                    using reference = value_type;
+                    using pointer = void;
+                    using difference_type = std::ptrdiff_t;
+                    using iterator_category = std::forward_iterator_tag;
+
+                    iterator() = default;
+                    iterator(view const *v, std::size_t idx) : _view(v), _idx(idx) { _skip(); }
+
+                    iterator &operator++() { ++_idx; _skip(); return *this; }
+                    iterator operator++(int) { auto r = *this; ++(*this); return r; }
+
+                    reference operator*() const { return _view->_values(_idx, _idx_seq); }
+
+                    /**
+                    ** \brief Index of the current entity.
+                    */
+                    [[nodiscard]] std::size_t index() const noexcept { return _idx; }
+
+                    friend bool operator==(iterator const &lhs, iterator const &rhs) { return lhs._idx == rhs._idx; }
+                    friend bool operator!=(iterator const &lhs, iterator const &rhs) { return !(lhs == rhs); }
+
+                private:
+                    void _skip() {
+                        while (_idx < _view->_bound && !_view->_match(_idx, _idx_seq))
+                            ++_idx;
+                    }
+
+                private:
+                    view const *_view = nullptr;
+                    std::size_t _idx = 0;
+            };
+
+        public:
+            /**
+            ** \brief Build a view over a components registry.
+            **
+            ** \throw std::out_of_range is thrown if an included component wasn't registered. Excluded components don't
+            ** have to be registered.
+            */
+            explicit view(components_registry &cr) : _columns{_column<Ts>(cr)...}, _bound(_compute_bound(_idx_seq)) {}
+
+            view(view const &) = default;
+            view(view &&) noexcept = default;
+
+            view &operator=(view const &) = default;
+            view &operator=(view &&) noexcept = default;
+
+            iterator begin() const { return iterator{this, 0}; }
+            iterator end() const { return iterator{this, _bound}; }
+
+            /**
+            ** \brief Upper bound of the matching entity indices.
+            **
+            ** A bound of zero means the view is empty. A non-zero bound does not mean any entity matches.
+            */
+            [[nodiscard]] std::size_t bound() const noexcept { return _bound; }
+
+            /**
+            ** \brief Whether no entity matches the view.
+            **
+            ** Scans up to the first matching entity, or the whole bound when there is none.
+            */
+            [[nodiscard]] bool empty() const { return begin() == end(); }
+
+            /**
+            ** \brief Components of the entity at idx.
+            **
+            ** \pre The entity at idx must match the view.
+            */
+            value_type operator[](std::size_t idx) const { return _values(idx, _idx_seq); }
+
+            /**
+            ** \brief Call f with the index and components of every matching entity.
+            **
+            ** This avoids going through iterators, and is the fastest way to walk a view.
+            */
+            template <class F>
+            void each(F &&f) const {
+                for (std::size_t i = 0; i < _bound; ++i)
+                    if (_match(i, _idx_seq))
+                        std::apply(f, std::tuple_cat(std::tuple<std::size_t>{i}, _values(i, _idx_seq)));
+            }
+
+            /**
+            ** \brief Record the components used by this view type.
+            */
+            static void describe(scheduling::access &acc) {
+                (_describe<Ts>(acc), ...);
+            }
+
+        private:
+            template <typename T>
+            static __impl::column<T> _column(components_registry &cr) {
+                using term_t = __impl::term<T>;
+
+                if constexpr (term_t::excluded) {
+                    if (!cr.has<typename term_t::component>())
+                        return {};
+                }
+
+                auto &cont = cr.get<typename term_t::component>();
+
+                return {cont.data(), cont.size()};
+            }
+
+            template <typename T>
+            static void _describe(scheduling::access &acc) {
+                using term_t = __impl::term<T>;
+
+                if constexpr (term_t::read_only)
+                    acc.read(typeid(typename term_t::component));
+                else
+                    acc.write(typeid(typename term_t::component));
+            }
+
+            template <std::size_t... Idx>
+            std::size_t _compute_bound(std::index_sequence<Idx...>) const noexcept {
+                std::size_t bound = std::numeric_limits<std::size_t>::max();
+
+                ((bound = __impl::term<Ts>::excluded ? bound : std::min(bound, std::get<Idx>(_columns).size)), ...);
+                return bound;
+            }
+
+            template <std::size_t... Idx>
+            bool _match(std::size_t idx, std::index_sequence<Idx...>) const noexcept {
+                return (true && ... && _match_one<Ts>(std::get<Idx>(_columns), idx));
+            }
+
+            template <typename T>
+            static bool _match_one(__impl::column<T> const &col, std::size_t idx) noexcept {
+                if constexpr (__impl::term<T>::excluded)
+                    return idx >= col.size || !col.data[idx];
+                else
+                    return col.data[idx].has_value();
+            }
+
+            template <std::size_t... Idx>
+            value_type _values(std::size_t idx, std::index_sequence<Idx...>) const {
+                return std::tuple_cat(_value<Ts>(std::get<Idx>(_columns), idx)...);
+            }
+
+            template <typename T>
+            static typename __impl::term<T>::values _value(__impl::column<T> const &col, std::size_t idx) {
+                if constexpr (__impl::term<T>::excluded)
+                    return {};
+                else
+                    return {*col.data[idx]};
+            }
+
+        private:
+            std::tuple<__impl::column<Ts>...> _columns;
+            std::size_t _bound;
+
+            static constexpr std::index_sequence_for<Ts...> _idx_seq{};
+    };
+
+    /**
+    ** \brief Check whether a type is a view.
+    */
+    template <typename> struct is_view : std::false_type {};
+    template <typename... Ts> struct is_view<view<Ts...>> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_view_v = is_view<T>::value;
+}
+
+#endif /* end of include guard: query_view_hpp__ */
@@ -0,0 +1,61 @@
+/**
+** \file access.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 13:20
+** \date Last update: 2026-10-18 13:20
+*/
+
+#ifndef scheduling_access_hpp__
+#define scheduling_access_hpp__
+
+#include <algorithm> // std::find, std::any_of
+#include <typeindex> // std::type_index
+#include <vector> // std::vector
+
+namespace hex::scheduling {
+    /**
+    ** \brief Component types a system reads and writes.
+    **
+    ** It is deduced from the system parameters upon registration: const containers and const view components are
+    ** reads, every other container or view component is a write. Other parameters are not tracked.
+    */
+    struct access {
+        std::vector<std::type_index> reads;
+        std::vector<std::type_index> writes;
+
+        /**
+        ** \brief Record a read. Does nothing if the type is already read or written.
+        */
+        void read(std::type_index type) {
+            if (!_has(writes, type) && !_has(reads, type))
+                reads.push_back(type);
+        }
+
+        /**
+        ** \brief Record a write. A type that was read becomes written.
+        */
+        void write(std::type_index type) {
+            if (auto it = std::find(reads.begin(), reads.end(), type); it != reads.end())
+                reads.erase(it);
+
+            if (!_has(writes, type))
+                writes.push_back(type);
+        }
+
+        /**
+        ** \brief Check whether two systems touch the same component, and at least one of them writes it.
+        */
+        [[nodiscard]] bool conflicts_with(access const &oth) const {
+            return std::any_of(writes.begin(), writes.end(), [&](auto const &t) { return _has(oth.reads, t) || _has(oth.writes, t); })
+                || std::any_of(oth.writes.begin(), oth.writes.end(), [&](auto const &t) { return _has(reads, t); });
+        }
+
+        private:
+            static bool _has(std::vector<std::type_index> const &types, std::type_index type) {
+                return std::find(types.begin(), types.end(), type) != types.end();
+            }
+    };
+}
+
+#endif /* end of include guard: scheduling_access_hpp__ */
@@ -0,0 +1,53 @@
+/**
+** \file handle.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 12:01
+** \date Last update: 2026-10-18 12:01
+*/
+
+#ifndef scheduling_handle_hpp__
+#define scheduling_handle_hpp__
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+
+namespace hex {
+    template <class ...> class system_registry;
+}
+
+namespace hex::scheduling {
+    /**
+    ** \brief System handle.
+    **
+    ** This opaque type is returned by system_registry::register_system, and identifies the registered system
+    ** when enabling, disabling or unregistering it.
+    **
+    ** It can be copied and moved, but cannot be constructed normally. A handle to an unregistered system stays
+    ** invalid, even if the registry reuses its slot.
+    */
+    class system_handle {
+        template <class ...> friend class hex::system_registry;
+
+        system_handle(std::size_t index, std::uint32_t generation) : _index(index), _generation(generation) {}
+
+        public:
+            system_handle(system_handle const &) = default;
+            system_handle(system_handle &&) = default;
+
+            system_handle &operator=(system_handle const &) = default;
+            system_handle &operator=(system_handle &&) = default;
+
+            friend bool operator==(system_handle const &lhs, system_handle const &rhs) {
+                return lhs._index == rhs._index && lhs._generation == rhs._generation;
+            }
+
+            friend bool operator!=(system_handle const &lhs, system_handle const &rhs) { return !(lhs == rhs); }
+
+        private:
+            std::size_t _index;
+            std::uint32_t _generation;
+    };
+}
+
+#endif /* end of include guard: scheduling_handle_hpp__ */
@@ -0,0 +1,78 @@
+/**
+** \file options.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 10:02
+** \date Last update: 2026-10-18 10:02
+*/
+
+#ifndef scheduling_options_hpp__
+#define scheduling_options_hpp__
+
+#include <string> // std::string
+#include <utility> // std::move
+#include <vector> // std::vector
+
+namespace hex::scheduling {
+    /**
+    ** \brief Name of the phase systems are put in when none is given.
+    */
+    inline constexpr char const *default_phase = "";
+
+    /**
+    ** \brief Describe where a system goes in the schedule.
+    **
+    ** Options are built fluently, and passed as the first parameter of system_registry::register_system:
+    ** <code>
+    **  registry.register_system(hex::named("physics").after("input").in_phase("update"), physics);
+    ** </code>
+    **
+    ** Constraints refer to other systems by name. A constraint on a name that has not been registered yet is kept,
+    ** and applies as soon as a system with that name is registered.
+    */
+    struct system_options {
+        std::string name; /**< Unique name of the system. Empty for anonymous systems. */
+        std::vector<std::string> run_before; /**< Systems this one must run before. */
+        std::vector<std::string> run_after; /**< Systems this one must run after. */
+        std::string phase = default_phase; /**< Phase the system runs in. */
+
+        /**
+        ** \brief Run this system before the system called other.
+        */
+        system_options &before(std::string other) {
+            run_before.push_back(std::move(other));
+            return *this;
+        }
+
+        /**
+        ** \brief Run this system after the system called other.
+        */
+        system_options &after(std::string other) {
+            run_after.push_back(std::move(other));
+            return *this;
+        }
+
+        /**
+        ** \brief Put this system in a phase.
+        **
+        ** Phases run in the order they were added to the registry. Every system of a phase runs before any
+        ** system of the next one.
+        */
+        system_options &in_phase(std::string p) {
+            phase = std::move(p);
+            return *this;
+        }
+    };
+
+    /**
+    ** \brief Start building the options of a named system.
+    */
+    inline system_options named(std::string name) {
+        system_options opts;
+
+        opts.name = std::move(name);
+        return opts;
+    }
+}
+
+#endif /* end of include guard: scheduling_options_hpp__ */
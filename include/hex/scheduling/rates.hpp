@@ -0,0 +1,94 @@
+/**
+** \file rates.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 11:02
+** \date Last update: 2026-10-18 11:02
+*/
+
+#ifndef scheduling_rates_hpp__
+#define scheduling_rates_hpp__
+
+#include <chrono> // std::chrono::steady_clock
+#include <cstddef> // std::size_t
+#include <variant> // std::variant
+
+namespace hex::scheduling {
+    /**
+    ** \brief Clock used to measure time between two ticks.
+    */
+    using clock = std::chrono::steady_clock;
+
+    /**
+    ** \brief Rates at which a phase of systems can run.
+    */
+    namespace rates {
+        /**
+        ** \brief Run on every tick. This is the default rate.
+        */
+        struct every_tick_t {};
+        static constexpr every_tick_t every_tick{};
+
+        /**
+        ** \brief Run once every ticks ticks.
+        **
+        ** If staggered is set, the systems of the phase are spread across the ticks instead of all running on the same
+        ** one: the system at position k in the phase runs on the ticks where (tick + k) % ticks == 0.
+        */
+        struct every_t {
+            std::size_t ticks;
+            bool staggered = false;
+        };
+
+        /**
+        ** \brief Run every ticks ticks, all on the same tick.
+        */
+        inline every_t every(std::size_t ticks) { return {ticks == 0 ? 1 : ticks, false}; }
+
+        /**
+        ** \brief Run every ticks ticks, spreading the systems of the phase across ticks.
+        */
+        inline every_t staggered(std::size_t ticks) { return {ticks == 0 ? 1 : ticks, true}; }
+
+        /**
+        ** \brief Run with a fixed time step.
+        **
+        ** Elapsed time is accumulated, and the phase runs once per step it contains. To avoid spiraling when ticks get
+        ** slow, at most max_steps are run per tick, and the remaining time is dropped.
+        */
+        struct fixed_step_t {
+            clock::duration step;
+            std::size_t max_steps = 4;
+        };
+
+        /**
+        ** \brief Run with a fixed time step.
+        */
+        inline fixed_step_t fixed_step(clock::duration step, std::size_t max_steps = 4) {
+            return {step > clock::duration::zero() ? step : clock::duration{1}, max_steps == 0 ? 1 : max_steps};
+        }
+
+        /**
+        ** \brief Run for a time budget per tick.
+        **
+        ** The systems of the phase are run in order, until the budget is spent. The next tick resumes with the next
+        ** system, so a slow phase is sliced across several ticks. At least one system runs per tick, and no system runs
+        ** twice in the same tick.
+        */
+        struct budget_t {
+            clock::duration budget;
+        };
+
+        /**
+        ** \brief Run for a time budget per tick.
+        */
+        inline budget_t budget(clock::duration budget) { return {budget}; }
+    }
+
+    /**
+    ** \brief Any of the phase rates.
+    */
+    using rate = std::variant<rates::every_tick_t, rates::every_t, rates::fixed_step_t, rates::budget_t>;
+}
+
+#endif /* end of include guard: scheduling_rates_hpp__ */
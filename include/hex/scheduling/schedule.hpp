@@ -0,0 +1,126 @@
+/**
+** \file schedule.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 10:10
+** \date Last update: 2026-10-18 10:10
+*/
+
+#ifndef scheduling_schedule_hpp__
+#define scheduling_schedule_hpp__
+
+#include <cstddef> // std::size_t
+#include <functional> // std::greater
+#include <queue> // std::priority_queue
+#include <string> // std::string
+#include <string_view> // std::string_view
+#include <unordered_map> // std::unordered_map
+#include <utility> // std::pair
+#include <vector> // std::vector
+
+#include "hex/exceptions/schedule_cycle.hpp"
+
+namespace hex::scheduling {
+    /**
+    ** \brief View on a system's ordering constraints, used to build a schedule.
+    */
+    struct node {
+        std::string const *name;
+        std::vector<std::string> const *before;
+        std::vector<std::string> const *after;
+        std::size_t phase; /**< Rank of the node's phase. */
+        std::size_t sequence; /**< Tie-break: among nodes that could run next, the lowest sequence runs first. */
+    };
+
+    /**
+    ** \brief Compute an execution order respecting every constraint.
+    **
+    ** Nodes are topologically sorted, such that every node runs after the nodes of the previous phases, and
+    ** before/after constraints hold. Among nodes that could run next, the one with the lowest sequence is picked,
+    ** so unconstrained systems keep their registration order.
+    **
+    ** Phases are modelled with one barrier per phase, so the cost is linear in the number of nodes and constraints.
+    **
+    ** \param [in] nodes Nodes to order.
+    ** \param [in] phases Number of phases.
+    **
+    ** \return Indices of the nodes, in execution order.
+    **
+    ** \throw hex::exceptions::schedule_cycle Thrown if the constraints cannot be satisfied.
+    */
+    inline std::vector<std::size_t> resolve(std::vector<node> const &nodes, std::size_t phases) {
+        using namespace std::string_literals;
+        using entry_t = std::pair<std::size_t, std::size_t>;
+
+        std::size_t const count = nodes.size();
+        std::vector<std::vector<std::size_t>> edges(count + phases);
+        std::vector<std::size_t> in_degree(count + phases, 0);
+        std::unordered_map<std::string_view, std::size_t> by_name;
+
+        auto add_edge = [&](std::size_t from, std::size_t to) {
+            edges[from].push_back(to);
+            ++in_degree[to];
+        };
+
+        for (std::size_t i = 0; i < count; ++i)
+            if (!nodes[i].name->empty())
+                by_name.emplace(*nodes[i].name, i);
+
+        for (std::size_t p = 0; p + 1 < phases; ++p)
+            add_edge(count + p, count + p + 1);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            add_edge(i, count + nodes[i].phase);
+
+            if (nodes[i].phase > 0)
+                add_edge(count + nodes[i].phase - 1, i);
+
+            for (auto const &other : *nodes[i].before)
+                if (auto it = by_name.find(other); it != by_name.end())
+                    add_edge(i, it->second);
+
+            for (auto const &other : *nodes[i].after)
+                if (auto it = by_name.find(other); it != by_name.end())
+                    add_edge(it->second, i);
+        }
+
+        // Barriers have priority 0 so they are released as soon as their phase is done.
+        auto priority = [&](std::size_t n) { return n < count ? nodes[n].sequence + 1 : 0; };
+        std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> ready;
+        std::vector<std::size_t> order;
+        std::size_t visited = 0;
+
+        order.reserve(count);
+        for (std::size_t n = 0; n < count + phases; ++n)
+            if (!in_degree[n])
+                ready.emplace(priority(n), n);
+
+        while (!ready.empty()) {
+            std::size_t n = ready.top().second;
+
+            ready.pop();
+            ++visited;
+
+            if (n < count)
+                order.push_back(n);
+
+            for (std::size_t next : edges[n])
+                if (!--in_degree[next])
+                    ready.emplace(priority(next), next);
+        }
+
+        if (visited != count + phases) {
+            std::string names;
+
+            for (std::size_t i = 0; i < count; ++i)
+                if (in_degree[i])
+                    names += (names.empty() ? ""s : ", "s) + (nodes[i].name->empty() ? "<anonymous>"s : *nodes[i].name);
+
+            throw hex::exceptions::schedule_cycle("[system_registry]: ordering constraints form a cycle involving: "s + names);
+        }
+
+        return order;
+    }
+}
+
+#endif /* end of include guard: scheduling_schedule_hpp__ */
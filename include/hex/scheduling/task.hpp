@@ -0,0 +1,197 @@
+/**
+** \file task.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 14:10
+** \date Last update: 2026-10-18 14:10
+*/
+
+#ifndef scheduling_task_hpp__
+#define scheduling_task_hpp__
+
+#include <coroutine> // std::coroutine_handle, std::suspend_always
+#include <exception> // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <functional> // std::function
+#include <optional> // std::optional
+#include <utility> // std::exchange, std::move
+
+#include "hex/scheduling/rates.hpp"
+
+namespace hex::scheduling {
+    /**
+    ** \brief Coroutine type of systems that can suspend across ticks.
+    **
+    ** A system returning a task is a coroutine. The registry creates the coroutine the first time the system runs, and
+    ** resumes it each time the system runs afterward, until it completes. The next run then creates a new one.
+    **
+    ** Inside the coroutine, the following can be awaited:
+    **  - next_tick: suspend until the system runs again.
+    **  - until(pred): suspend until pred returns true, checked each time the system runs.
+    **  - next_event<Event>(dispatcher): suspend until an event can be polled from the dispatcher.
+    **  - yield_after(duration): suspend if the coroutine has been running for longer than duration.
+    **
+    ** \warning Components containers and views are fetched when the coroutine is created. Views, and references to
+    ** components, should not be kept across suspension points, as containers may be resized in between.
+    */
+    class task {
+        public:
+            class promise_type {
+                public:
+                    task get_return_object() { return task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+
+                    std::suspend_always initial_suspend() const noexcept { return {}; }
+                    std::suspend_always final_suspend() const noexcept { return {}; }
+
+                    void return_void() const noexcept {}
+                    void unhandled_exception() noexcept { _exception = std::current_exception(); }
+
+                    /**
+                    ** \brief Do not resume the coroutine until ready returns true.
+                    */
+                    void wait_until(std::function<bool ()> ready) { _ready = std::move(ready); }
+
+                    /**
+                    ** \brief Time elapsed since the coroutine was last resumed.
+                    */
+                    [[nodiscard]] clock::duration elapsed() const { return _now ? (*_now)() - _resumed_at : clock::duration{}; }
+
+                private:
+                    friend task;
+
+                    std::function<bool ()> _ready;
+                    std::function<clock::time_point ()> const *_now = nullptr;
+                    clock::time_point _resumed_at;
+                    std::exception_ptr _exception;
+            };
+
+            using handle_type = std::coroutine_handle<promise_type>;
+
+        public:
+            task() noexcept = default;
+            task(task const &) = delete;
+            task(task &&oth) noexcept : _handle(std::exchange(oth._handle, nullptr)) {}
+
+            task &operator=(task const &) = delete;
+            task &operator=(task &&oth) noexcept {
+                if (this != &oth) {
+                    _destroy();
+                    _handle = std::exchange(oth._handle, nullptr);
+                }
+
+                return *this;
+            }
+
+            ~task() { _destroy(); }
+
+            /**
+            ** \brief Check whether there is nothing left to resume.
+            */
+            [[nodiscard]] bool done() const noexcept { return !_handle || _handle.done(); }
+
+            /**
+            ** \brief Resume the coroutine, unless it is waiting on a condition that does not hold yet.
+            **
+            ** \param [in] now Clock used to measure the time spent in the coroutine. Must outlive the task.
+            **
+            ** \throw Rethrows any exception escaping the coroutine. The task is then done.
+            */
+            void resume(std::function<clock::time_point ()> const &now) {
+                if (done())
+                    return;
+
+                auto &p = _handle.promise();
+
+                if (p._ready && !p._ready())
+                    return;
+
+                p._ready = nullptr;
+                p._now = &now;
+                p._resumed_at = now();
+                _handle.resume();
+
+                if (p._exception)
+                    std::rethrow_exception(std::exchange(p._exception, nullptr));
+            }
+
+        private:
+            explicit task(handle_type h) noexcept : _handle(h) {}
+
+            void _destroy() noexcept {
+                if (_handle)
+                    _handle.destroy();
+                _handle = nullptr;
+            }
+
+        private:
+            handle_type _handle = nullptr;
+    };
+
+    /**
+    ** \brief Awaitable suspending a system until it runs again.
+    */
+    struct next_tick_t {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<>) const noexcept {}
+        void await_resume() const noexcept {}
+    };
+
+    inline constexpr next_tick_t next_tick{};
+
+    /**
+    ** \brief Awaitable suspending a system until a predicate holds.
+    */
+    template <class Pred>
+    struct until_t {
+        Pred pred;
+
+        bool await_ready() { return pred(); }
+        void await_suspend(task::handle_type h) { h.promise().wait_until([this]() { return static_cast<bool>(pred()); }); }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+    ** \brief Suspend until pred returns true. If it already does, the coroutine goes on without suspending.
+    */
+    template <class Pred>
+    until_t<Pred> until(Pred pred) { return {std::move(pred)}; }
+
+    /**
+    ** \brief Awaitable suspending a system until an event is polled.
+    */
+    template <typename Event, class Dispatcher>
+    struct next_event_t {
+        Dispatcher &dispatcher;
+        std::optional<Event> event = std::nullopt;
+
+        bool await_ready() { return _poll(); }
+        void await_suspend(task::handle_type h) { h.promise().wait_until([this]() { return _poll(); }); }
+        Event await_resume() { return std::move(*event); }
+
+        private:
+            bool _poll() {
+                event = dispatcher.template poll<Event>();
+                return event.has_value();
+            }
+    };
+
+    /**
+    ** \brief Suspend until an Event can be polled from dispatcher, and return it.
+    **
+    ** \pre Event must have been declared as a polling event.
+    */
+    template <typename Event, class Dispatcher>
+    next_event_t<Event, Dispatcher> next_event(Dispatcher &dispatcher) { return {dispatcher}; }
+
+    /**
+    ** \brief Awaitable suspending a system when it ran out of time.
+    */
+    struct yield_after {
+        clock::duration budget;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(task::handle_type h) const { return h.promise().elapsed() >= budget; }
+        void await_resume() const noexcept {}
+    };
+}
+
+#endif /* end of include guard: scheduling_task_hpp__ */
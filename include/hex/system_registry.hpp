@@ -3,24 +3,40 @@
 **
 ** \author Phantomas <phantomas@phantomas.xyz>
 ** \date Created on: 2022-01-01 18:34
-** \date Last update: 2023-01-31 11:08
+** \date Last update: 2026-10-18 09:40
 */
 
 #ifndef SYSTEM_REGISTRY_HPP_
 #define SYSTEM_REGISTRY_HPP_
 
+#include <algorithm> // std::find_if
+#include <chrono> // std::chrono::duration
+#include <cstdint> // std::uint32_t
 #include <functional> // std::function
 #include <memory> // std::shared_ptr
 #include <stdexcept> // std::invalid_argument
-#include <string> // std::string_literals;
+#include <string> // std::string, std::string_literals, std::to_string
+#include <tuple> // std::tuple, std::apply
 #include <type_traits> // std::enable_if, std::disjunction, std::is_same, std::negation_v, std::remove_cv_t, std::remove_reference_t
+#include <typeindex> // std::type_index
+#include <unordered_set> // std::unordered_set
 #include <utility> // std::forward
+#include <variant> // std::get_if
 #include <vector> // std::vector
 
 #include "hex/components_registry.hpp"
 #include "hex/entity_manager.hpp"
+#include "hex/exceptions/already_registered.hpp"
 #include "hex/exceptions/unimplemented.hpp"
 #include "hex/exceptions/no_such_component.hpp"
+#include "hex/query/view.hpp"
+#include "hex/scheduling/access.hpp"
+#include "hex/scheduling/handle.hpp"
+#include "hex/scheduling/options.hpp"
+#include "hex/scheduling/rates.hpp"
+#include "hex/scheduling/schedule.hpp"
+#include "hex/scheduling/task.hpp"
+#include "hex/tracing/sink.hpp"
 
 namespace hex {
     template <class ...> class system_registry;
@@ -71,6 +87,16 @@ namespace hex {
             }
         };
 
+        template <class ...Args, class ...Ts> struct Getter<system_registry<Args...>, query::view<Ts...>> {
+            inline static query::view<Ts...> get(
+                    system_registry<Args...> &sr,
+                    entity_manager &em,
+                    components_registry &cr,
+                    std::tuple<Args &...> const &args) {
+                return query::view<Ts...>{cr};
+            }
+        };
+
         template <class ...Args, class T> struct Getter<system_registry<Args...>, T> {
             inline static T &get(
                     system_registry<Args...> &sr,
@@ -116,6 +142,11 @@ namespace hex {
             using type = hex::containers::sparse_array<T, Allocator>;
         };
 
+        template <class... Args, typename... Ts>
+        struct argument_helper<system_registry<Args...>, hex::query::view<Ts...>> {
+            using type = hex::query::view<Ts...>;
+        };
+
         template <class... Args> struct argument_helper<system_registry<Args...>, hex::entity_manager> {
             using type = hex::entity_manager;
         };
@@ -154,6 +185,20 @@ namespace hex {
             static constexpr sys_args_deduction_helper<type, constness> helper{};
         };
 
+        template <typename T, typename ...As>
+        struct sys_signature<scheduling::task (T::*)(As...)> {
+            using type = void (As...);
+            static constexpr bool constness = false;
+            static constexpr sys_args_deduction_helper<type, constness> helper{};
+        };
+
+        template <typename T, typename ...As>
+        struct sys_signature<scheduling::task (T::*)(As...) const> {
+            using type = void (As...);
+            static constexpr bool constness = true;
+            static constexpr sys_args_deduction_helper<type, constness> helper{};
+        };
+
         template <typename T> struct remove_sparse_array {
             using type = T;
         };
@@ -164,6 +209,12 @@ namespace hex {
 
         template <typename T>
         using remove_sparse_array_t = typename remove_sparse_array<T>::type;
+
+        template <typename T>
+        inline bool is_empty_arg(T const &) noexcept { return false; }
+
+        template <typename... Ts>
+        inline bool is_empty_arg(query::view<Ts...> const &v) { return v.empty(); }
     }
     /**
     ** \endcond Internals
@@ -192,6 +243,15 @@ namespace hex {
     static constexpr auto_register_t auto_register{};
     /** @} */
 
+    /// Re-expose scheduling::system_options as hex::system_options.
+    using scheduling::system_options;
+
+    /// Re-expose scheduling::named as hex::named.
+    using scheduling::named;
+
+    /// Re-expose scheduling::system_handle as hex::system_handle.
+    using scheduling::system_handle;
+
     /**
     ** \brief Manages systems
     **
@@ -217,10 +277,45 @@ namespace hex {
     ** \subsection auto_registration Auto-register components
     ** If auto_register_t is passed to one of the register_system functions, types detected as components will be registered in the components_registry.
     **
+    ** \subsection scheduling_systems Scheduling systems
+    ** A system_options can be passed as the first parameter of register_system, to name the system, and to constrain
+    ** its position with before/after other named systems, or with the phase it belongs to.
+    ** The constraints are resolved into a schedule upon registration, so cycles are detected early, and run only walks the
+    ** cached schedule.
+    **
+    ** \subsection system_rates Phase rates
+    ** Each phase runs at a rate, set with add_phase or set_phase_rate: on every tick, every N ticks (possibly spreading
+    ** its systems across the N ticks), with a fixed time step, or for a time budget per tick, resuming where it stopped on
+    ** the next tick. Systems can read the time step of their phase with delta().
+    **
+    ** \subsection system_views Views
+    ** A system can take query::view parameters, by value, instead of whole containers. Such a system is not called when
+    ** no entity matches one of its views. The components a system reads and writes, through views or containers, are recorded
+    ** upon registration and can be retrieved with access().
+    **
+    ** \subsection system_coroutines Coroutine systems
+    ** A callable returning a scheduling::task is a coroutine system. Each run resumes it, so long-running work can be
+    ** spread across ticks by awaiting scheduling::next_tick, scheduling::until, scheduling::next_event or
+    ** scheduling::yield_after. Once the coroutine completes, the next run starts a new one.
+    ** Coroutine systems must be callable objects, such as lambdas: free functions have to be wrapped.
+    ** Their parameters are bound once, when the coroutine starts, and are kept across ticks: they can only be the
+    ** registries and component containers, which outlive every run. Views and run arguments are only valid during the
+    ** run they are passed to, and are rejected at compile time; build views from the components registry after each
+    ** suspension instead.
+    **
+    ** \subsection system_handles System handles
+    ** Every register_system overload returns a system_handle. It can be used to disable a system, which is then skipped
+    ** by run without being called, to enable it back, or to unregister it. All three operations are constant time.
+    **
     ** \section system_call System Call
-    ** Upon a call to system_registry::run, every systems are called in the order in which they were registered to the registry.
+    ** Upon a call to system_registry::run, every systems are called in the order of the schedule. Systems that are not
+    ** constrained are called in the order in which they were registered to the registry.
     ** Components containers are retrieved from the components_registry associated with this class.
     **
+    ** \section system_tracing Tracing
+    ** If a tracing::sink is set with system_registry::set_trace_sink, each call to run, and each system call, is recorded
+    ** as a duration event. Without a sink, run does not pay for tracing.
+    **
     ** \see SystemRegistryTag
     */
     template <class... Args>
@@ -233,6 +328,37 @@ namespace hex {
             using caller_t = std::function<void (system_registry &, std::tuple<Args &...> const &)>;
             using Self = system_registry;
 
+            /**
+            ** \brief Registered system, its scheduling constraints, and the name used when tracing it.
+            */
+            struct system_entry {
+                caller_t call;
+                std::string name;
+                char const *trace_name;
+                std::vector<std::string> before;
+                std::vector<std::string> after;
+                std::size_t phase;
+                std::size_t sequence; /**< Registration rank, ordering unconstrained systems. */
+                scheduling::access access; /**< Components read and written by the system. */
+                std::uint32_t generation;
+                bool enabled; /**< Disabled systems are skipped by run. */
+                bool alive; /**< False once unregistered, until the slot is reused. */
+            };
+
+            /**
+            ** \brief Phase, the rate it runs at, and its slice of the schedule.
+            */
+            struct phase_entry {
+                std::string name;
+                scheduling::rate rate = scheduling::rates::every_tick;
+                std::size_t begin = 0; /**< First index of the phase in _schedule. */
+                std::size_t end = 0; /**< Past-the-end index of the phase in _schedule. */
+                std::size_t cursor = 0; /**< Next system to run, for budget rates. */
+                scheduling::clock::duration accumulator{};
+                scheduling::clock::time_point last_run{};
+                bool ran = false;
+            };
+
         public:
             /**
             ** \brief Contruct a system_registry.
@@ -272,13 +398,55 @@ namespace hex {
             */
             void run(Args &... as) {
                 auto run_args = std::tie(as...);
-                for (auto &f: _systems)
-                    f(*this, run_args);
+
+                if (_trace)
+                    _run<true>(run_args);
+                else
+                    _run<false>(run_args);
+
+                ++_tick;
             }
+
+            /**
+            ** \brief Number of completed calls to run.
+            */
+            [[nodiscard]] std::size_t tick() const noexcept { return _tick; }
+
+            /**
+            ** \brief Time step of the phase being run.
+            **
+            ** For fixed_step phases, this is the step. Otherwise, it is the time elapsed since the phase last ran,
+            ** or zero the first time it runs.
+            */
+            [[nodiscard]] scheduling::clock::duration delta() const noexcept { return _delta; }
+            /** @} */
+
+            /**
+            ** \name Tracing
+            */
+            /** @{ */
+            /**
+            ** \brief Record run and system calls to a tracing sink.
+            **
+            ** \param [in] sink Sink to record to. Passing nullptr disables tracing.
+            */
+            void set_trace_sink(std::shared_ptr<tracing::sink> sink) {
+                _trace = std::move(sink);
+
+                for (auto &s : _systems)
+                    s.trace_name = _trace ? _trace->intern(s.name) : nullptr;
+            }
+
+            /**
+            ** \brief Get the current tracing sink, if any.
+            */
+            [[nodiscard]] std::shared_ptr<tracing::sink> const &trace_sink() const noexcept { return _trace; }
             /** @} */
 
             /**
             ** \name System registration
+            **
+            ** Every overload returns a system_handle to the registered system.
             */
             /** @{ */
             /**
@@ -290,8 +458,8 @@ namespace hex {
             ** \tparam Callable Type of the system to register.
             */
             template <typename... As, class Callable, typename = std::enable_if_t<sizeof...(As) != 0>>
-            void register_system(Callable &&c) {
-                return _do_register<false, As...>(std::forward<Callable>(c));
+            system_handle register_system(Callable &&c) {
+                return _do_register<false, As...>(system_options{}, std::forward<Callable>(c));
             }
 
             /**
@@ -302,9 +470,9 @@ namespace hex {
             ** \tparam Callable Type of the system.
             */
             template <class Callable>
-            void register_system(Callable &&c) {
+            system_handle register_system(Callable &&c) {
                 using callable_type = std::remove_cv_t<std::remove_reference_t<Callable>>;
-                return _do_register(std::forward<Callable>(c), __impl::sys_signature<decltype(&callable_type::operator())>::helper);
+                return _do_register(system_options{}, std::forward<Callable>(c), __impl::sys_signature<decltype(&callable_type::operator())>::helper);
             }
 
             /**
@@ -315,8 +483,8 @@ namespace hex {
             ** \tparam As Systems parameters types.
             */
             template <typename ...As>
-            void register_system(system_fptr_t<As...> const f) {
-                return _do_register<true, As...>(std::move(f));
+            system_handle register_system(system_fptr_t<As...> const f) {
+                return _do_register<true, As...>(system_options{}, std::move(f));
             }
 
             /**
@@ -329,10 +497,10 @@ namespace hex {
             ** \tparam Callable Type of the system to register.
             */
             template <typename... As, class Callable, typename = std::enable_if_t<sizeof...(As) != 0>>
-            void register_system([[maybe_unused]]check_t t, Callable &&c) {
+            system_handle register_system([[maybe_unused]]check_t t, Callable &&c) {
                 _check_arguments<As...>();
 
-                return _do_register<false, As...>(std::forward<Callable>(c));
+                return _do_register<false, As...>(system_options{}, std::forward<Callable>(c));
             }
 
             /**
@@ -344,12 +512,12 @@ namespace hex {
             ** \tparam Callable Type of the system.
             */
             template <class Callable>
-            void register_system([[maybe_unused]]check_t t, Callable &&c) {
+            system_handle register_system([[maybe_unused]]check_t t, Callable &&c) {
                 using callable_type = std::remove_cv_t<std::remove_reference_t<Callable>>;
                 auto helper = __impl::sys_signature<decltype(&callable_type::operator())>::helper;
 
                 _check_arguments(helper);
-                return _do_register(std::forward<Callable>(c), helper);
+                return _do_register(system_options{}, std::forward<Callable>(c), helper);
             }
 
             /**
@@ -361,10 +529,10 @@ namespace hex {
             ** \tparam As Systems parameters types.
             */
             template <typename ...As>
-            void register_system([[maybe_unused]]check_t t, system_fptr_t<As...> const f) {
+            system_handle register_system([[maybe_unused]]check_t t, system_fptr_t<As...> const f) {
                 _check_arguments<As...>();
 
-                return _do_register<true, As...>(std::move(f));
+                return _do_register<true, As...>(system_options{}, std::move(f));
             }
 
             /**
@@ -377,10 +545,10 @@ namespace hex {
             ** \tparam Callable Type of the system to register.
             */
             template <typename... As, class Callable, typename = std::enable_if_t<sizeof...(As) != 0>>
-            void register_system([[maybe_unused]]auto_register_t t, Callable &&c) {
+            system_handle register_system([[maybe_unused]]auto_register_t t, Callable &&c) {
                 _register_arguments<As...>();
 
-                return _do_register<false, As...>(std::forward<Callable>(c));
+                return _do_register<false, As...>(system_options{}, std::forward<Callable>(c));
             }
 
             /**
@@ -392,12 +560,12 @@ namespace hex {
             ** \tparam Callable Type of the system.
             */
             template <class Callable>
-            void register_system([[maybe_unused]]auto_register_t t, Callable &&c) {
+            system_handle register_system([[maybe_unused]]auto_register_t t, Callable &&c) {
                 using callable_type = std::remove_cv_t<std::remove_reference_t<Callable>>;
                 auto helper = __impl::sys_signature<decltype(&callable_type::operator())>::helper;
 
                 _register_arguments(helper);
-                return _do_register(std::forward<Callable>(c), helper);
+                return _do_register(system_options{}, std::forward<Callable>(c), helper);
             }
 
             /**
@@ -409,25 +577,467 @@ namespace hex {
             ** \tparam As Systems parameters types.
             */
             template <typename ...As>
-            void register_system([[maybe_unused]]auto_register_t t, system_fptr_t<As...> const f) {
+            system_handle register_system([[maybe_unused]]auto_register_t t, system_fptr_t<As...> const f) {
                 _register_arguments<As...>();
 
-                return _do_register<true, As...>(std::move(f));
+                return _do_register<true, As...>(system_options{}, std::move(f));
+            }
+            /** @} */
+
+            /**
+            ** \name Scheduled system registration
+            **
+            ** These overloads take a system_options as their first parameter, to name the system and constrain its position
+            ** in the schedule. They otherwise behave like their counterpart without options.
+            **
+            ** \throw hex::exceptions::already_registered Thrown if a system with the same name was already registered.
+            ** \throw hex::exceptions::schedule_cycle Thrown if the constraints cannot be satisfied. The system is not registered.
+            */
+            /** @{ */
+            /**
+            ** \brief Scheduled system registration with explicit parameter types.
+            */
+            template <typename... As, class Callable, typename = std::enable_if_t<sizeof...(As) != 0>>
+            system_handle register_system(system_options opts, Callable &&c) {
+                return _do_register<false, As...>(std::move(opts), std::forward<Callable>(c));
+            }
+
+            /**
+            ** \brief Scheduled system registration with deduced parameter types.
+            */
+            template <class Callable>
+            system_handle register_system(system_options opts, Callable &&c) {
+                using callable_type = std::remove_cv_t<std::remove_reference_t<Callable>>;
+                return _do_register(std::move(opts), std::forward<Callable>(c), __impl::sys_signature<decltype(&callable_type::operator())>::helper);
+            }
+
+            /**
+            ** \brief Scheduled system registration for free function.
+            */
+            template <typename ...As>
+            system_handle register_system(system_options opts, system_fptr_t<As...> const f) {
+                return _do_register<true, As...>(std::move(opts), std::move(f));
+            }
+
+            /**
+            ** \brief Scheduled system registration with explicit parameter types, and component registration check.
+            */
+            template <typename... As, class Callable, typename = std::enable_if_t<sizeof...(As) != 0>>
+            system_handle register_system(system_options opts, [[maybe_unused]]check_t t, Callable &&c) {
+                _check_arguments<As...>();
+
+                return _do_register<false, As...>(std::move(opts), std::forward<Callable>(c));
+            }
+
+            /**
+            ** \brief Scheduled system registration with deduced parameter types, and component registration check.
+            */
+            template <class Callable>
+            system_handle register_system(system_options opts, [[maybe_unused]]check_t t, Callable &&c) {
+                using callable_type = std::remove_cv_t<std::remove_reference_t<Callable>>;
+                auto helper = __impl::sys_signature<decltype(&callable_type::operator())>::helper;
+
+                _check_arguments(helper);
+                return _do_register(std::move(opts), std::forward<Callable>(c), helper);
+            }
+
+            /**
+            ** \brief Scheduled system registration for free function, with component registration check.
+            */
+            template <typename ...As>
+            system_handle register_system(system_options opts, [[maybe_unused]]check_t t, system_fptr_t<As...> const f) {
+                _check_arguments<As...>();
+
+                return _do_register<true, As...>(std::move(opts), std::move(f));
+            }
+
+            /**
+            ** \brief Scheduled system registration with explicit parameter types, and component auto-registration.
+            */
+            template <typename... As, class Callable, typename = std::enable_if_t<sizeof...(As) != 0>>
+            system_handle register_system(system_options opts, [[maybe_unused]]auto_register_t t, Callable &&c) {
+                _register_arguments<As...>();
+
+                return _do_register<false, As...>(std::move(opts), std::forward<Callable>(c));
+            }
+
+            /**
+            ** \brief Scheduled system registration with deduced parameter types, and component auto-registration.
+            */
+            template <class Callable>
+            system_handle register_system(system_options opts, [[maybe_unused]]auto_register_t t, Callable &&c) {
+                using callable_type = std::remove_cv_t<std::remove_reference_t<Callable>>;
+                auto helper = __impl::sys_signature<decltype(&callable_type::operator())>::helper;
+
+                _register_arguments(helper);
+                return _do_register(std::move(opts), std::forward<Callable>(c), helper);
+            }
+
+            /**
+            ** \brief Scheduled system registration for free function, with component auto-registration.
+            */
+            template <typename ...As>
+            system_handle register_system(system_options opts, [[maybe_unused]]auto_register_t t, system_fptr_t<As...> const f) {
+                _register_arguments<As...>();
+
+                return _do_register<true, As...>(std::move(opts), std::move(f));
+            }
+            /** @} */
+
+            /**
+            ** \name System handling
+            */
+            /** @{ */
+            /**
+            ** \brief Check whether a handle refers to a registered system.
+            */
+            [[nodiscard]] bool contains(system_handle const &h) const noexcept {
+                return h._index < _systems.size() && _systems[h._index].alive && _systems[h._index].generation == h._generation;
+            }
+
+            /**
+            ** \brief Check whether a system is registered and enabled.
+            */
+            [[nodiscard]] bool is_enabled(system_handle const &h) const noexcept {
+                return contains(h) && _systems[h._index].enabled;
+            }
+
+            /**
+            ** \brief Enable a system, so it is called by run again.
+            **
+            ** \return False if the handle does not refer to a registered system.
+            */
+            bool enable(system_handle const &h) noexcept {
+                if (!contains(h))
+                    return false;
+
+                _systems[h._index].enabled = true;
+                return true;
+            }
+
+            /**
+            ** \brief Disable a system. It keeps its place in the schedule, but is skipped by run.
+            **
+            ** \return False if the handle does not refer to a registered system.
+            */
+            bool disable(system_handle const &h) noexcept {
+                if (!contains(h))
+                    return false;
+
+                _systems[h._index].enabled = false;
+                return true;
+            }
+
+            /**
+            ** \brief Components read and written by a system.
+            **
+            ** \throw std::invalid_argument is thrown if the handle does not refer to a registered system.
+            */
+            [[nodiscard]] scheduling::access const &access(system_handle const &h) const {
+                if (!contains(h))
+                    throw std::invalid_argument("[system_registry]: invalid system handle.");
+
+                return _systems[h._index].access;
+            }
+
+            /**
+            ** \brief Unregister a system.
+            **
+            ** The system is destroyed right away. Constraints other systems have on its name are kept, and apply to any
+            ** system registered later on with the same name.
+            **
+            ** \return False if the handle does not refer to a registered system.
+            */
+            bool unregister_system(system_handle const &h) {
+                if (!contains(h))
+                    return false;
+
+                auto &s = _systems[h._index];
+
+                _names.erase(s.name);
+                s.call = nullptr;
+                s.enabled = false;
+                s.alive = false;
+                _released.push_back(h._index);
+
+                return true;
+            }
+            /** @} */
+
+            /**
+            ** \name Scheduling
+            */
+            /** @{ */
+            /**
+            ** \brief Add a phase after the existing ones.
+            **
+            ** Phases used by a system without having been added are added when the system is registered.
+            ** The default phase always comes first.
+            **
+            ** \return False if the phase already existed.
+            */
+            bool add_phase(std::string const &phase) {
+                if (_phase_rank(phase) != _phases.size())
+                    return false;
+
+                _phases.push_back(phase_entry{phase});
+                _reschedule();
+
+                return true;
+            }
+
+            /**
+            ** \brief Add a phase after the existing ones, running at the given rate.
+            **
+            ** \return False if the phase already existed. Its rate is left untouched.
+            */
+            bool add_phase(std::string const &phase, scheduling::rate rate) {
+                if (!add_phase(phase))
+                    return false;
+
+                _phases.back().rate = rate;
+                return true;
+            }
+
+            /**
+            ** \brief Change the rate of a phase, adding the phase if needed.
+            **
+            ** Time accumulated by the phase is reset.
+            */
+            void set_phase_rate(std::string const &phase, scheduling::rate rate) {
+                add_phase(phase);
+
+                auto &p = _phases[_phase_rank(phase)];
+                p.rate = rate;
+                p.accumulator = {};
+                p.cursor = 0;
+            }
+
+            /**
+            ** \brief Set the function used to read the current time.
+            **
+            ** The default is scheduling::clock::now. This is mostly useful to replay, or to test, timed phases.
+            */
+            void set_clock(std::function<scheduling::clock::time_point ()> now) {
+                _now = std::move(now);
+            }
+
+            /**
+            ** \brief Names of the registered systems, in execution order. Disabled systems are included.
+            */
+            [[nodiscard]] std::vector<std::string> schedule() const {
+                std::vector<std::string> names;
+
+                names.reserve(_schedule.size());
+                for (std::size_t i : _schedule)
+                    if (_systems[i].alive)
+                        names.push_back(_systems[i].name);
+
+                return names;
             }
             /** @} */
         private:
+            template <bool traced>
+            void _run(std::tuple<Args &...> const &run_args) {
+                tracing::scope run_scope{traced ? _trace.get() : nullptr, "system_registry::run", "systems"};
+                auto now = _now();
+
+                for (auto &p : _phases) {
+                    if (p.begin == p.end)
+                        continue;
+
+                    _delta = p.ran ? now - p.last_run : scheduling::clock::duration::zero();
+
+                    if (std::holds_alternative<scheduling::rates::every_tick_t>(p.rate)) {
+                        _run_range<traced>(p.begin, p.end, run_args);
+                    } else if (auto every = std::get_if<scheduling::rates::every_t>(&p.rate)) {
+                        if (!every->staggered) {
+                            if (_tick % every->ticks)
+                                continue;
+
+                            _run_range<traced>(p.begin, p.end, run_args);
+                        } else {
+                            for (std::size_t i = p.begin; i < p.end; ++i)
+                                if (!((_tick + i - p.begin) % every->ticks))
+                                    _call<traced>(_schedule[i], run_args);
+                        }
+                    } else if (auto fixed = std::get_if<scheduling::rates::fixed_step_t>(&p.rate)) {
+                        std::size_t steps = 0;
+
+                        p.accumulator += _delta;
+                        _delta = fixed->step;
+
+                        for (; p.accumulator >= fixed->step && steps < fixed->max_steps; ++steps) {
+                            _run_range<traced>(p.begin, p.end, run_args);
+                            p.accumulator -= fixed->step;
+                        }
+
+                        if (p.accumulator >= fixed->step)
+                            p.accumulator %= fixed->step;
+                    } else if (auto budget = std::get_if<scheduling::rates::budget_t>(&p.rate)) {
+                        std::size_t count = p.end - p.begin;
+                        auto start = _now(); // Earlier phases must not eat into this phase's budget.
+
+                        if (p.cursor >= count)
+                            p.cursor = 0;
+
+                        do {
+                            _call<traced>(_schedule[p.begin + p.cursor], run_args);
+                            ++p.cursor;
+                        } while (p.cursor < count && _now() - start < budget->budget);
+                    }
+
+                    p.last_run = now;
+                    p.ran = true;
+                }
+
+                _delta = {};
+            }
+
+            template <bool traced>
+            void _run_range(std::size_t begin, std::size_t end, std::tuple<Args &...> const &run_args) {
+                for (std::size_t i = begin; i < end; ++i)
+                    _call<traced>(_schedule[i], run_args);
+            }
+
+            template <bool traced>
+            void _call(std::size_t i, std::tuple<Args &...> const &run_args) {
+                if (!_systems[i].enabled)
+                    return;
+
+                tracing::scope system_scope{traced ? _trace.get() : nullptr, _systems[i].trace_name, "system"};
+
+                _systems[i].call(*this, run_args);
+            }
+
+            system_handle _add_system(system_options &&opts, scheduling::access &&access, caller_t &&call) {
+                using namespace std::string_literals;
+
+                bool named = !opts.name.empty();
+
+                if (named && !_names.emplace(opts.name).second)
+                    throw hex::exceptions::already_registered("[system_registry]: a system named "s + opts.name + " is already registered."s);
+
+                std::size_t phases = _phases.size();
+                std::size_t phase = _phase_rank(opts.phase);
+
+                if (phase == phases)
+                    _phases.push_back(phase_entry{opts.phase});
+
+                bool reused = !_free.empty();
+                std::size_t index = reused ? _free.back() : _systems.size();
+                std::uint32_t generation = reused ? _systems[index].generation + 1 : 0;
+                system_entry entry{
+                    std::move(call),
+                    named ? std::move(opts.name) : "system #"s + std::to_string(index),
+                    nullptr,
+                    std::move(opts.run_before),
+                    std::move(opts.run_after),
+                    phase,
+                    _registered,
+                    std::move(access),
+                    generation,
+                    true,
+                    true
+                };
+
+                if (reused) {
+                    std::swap(_systems[index], entry);
+                    _free.pop_back();
+                } else {
+                    _systems.push_back(std::move(entry));
+                }
+
+                try {
+                    _reschedule();
+                } catch (...) {
+                    if (named) _names.erase(_systems[index].name);
+
+                    if (reused) {
+                        std::swap(_systems[index], entry);
+                        _free.push_back(index);
+                    } else {
+                        _systems.pop_back();
+                    }
+
+                    _phases.resize(phases);
+                    throw;
+                }
+
+                ++_registered;
+
+                if (_trace)
+                    _systems[index].trace_name = _trace->intern(_systems[index].name);
+
+                return system_handle{index, generation};
+            }
+
+            std::size_t _phase_rank(std::string const &phase) const {
+                return std::find_if(_phases.begin(), _phases.end(), [&](auto const &p) { return p.name == phase; }) - _phases.begin();
+            }
+
+            void _reschedule() {
+                std::vector<scheduling::node> nodes;
+
+                std::vector<std::size_t> indices;
+
+                nodes.reserve(_systems.size());
+                indices.reserve(_systems.size());
+                for (std::size_t i = 0; i < _systems.size(); ++i) {
+                    auto const &s = _systems[i];
+
+                    if (s.alive) {
+                        nodes.push_back({&s.name, &s.before, &s.after, s.phase, s.sequence});
+                        indices.push_back(i);
+                    }
+                }
+
+                _schedule = scheduling::resolve(nodes, _phases.size());
+
+                for (auto &i : _schedule)
+                    i = indices[i];
+
+                // Unregistered slots are out of the schedule now, so they can be reused.
+                _free.insert(_free.end(), _released.begin(), _released.end());
+                _released.clear();
+
+                // Phases are strictly ordered, so each one is a contiguous slice of the schedule.
+                for (auto &p : _phases)
+                    p.begin = p.end = 0;
+
+                for (std::size_t i = 0; i < _schedule.size(); ++i) {
+                    auto &p = _phases[_systems[_schedule[i]].phase];
+
+                    if (p.begin == p.end)
+                        p.begin = i;
+                    p.end = i + 1;
+                }
+            }
+
             template <typename Arg>
-            auto &_get_arg(std::tuple<Args &...> const & run_args) {
+            decltype(auto) _get_arg(std::tuple<Args &...> const & run_args) {
                 using _Arg = __impl::argument_helper_t<Self, std::remove_cv_t<std::remove_reference_t<Arg>>>;
                 return __impl::Getter<Self, _Arg>::get(*this, *_entities, *_components, run_args);
             }
 
+            /**
+            ** \brief Whether the argument is only valid for the run it is passed to.
+            */
+            template <typename Arg>
+            static constexpr bool _is_per_run_arg() {
+                using _Arg = __impl::argument_helper_t<Self, std::remove_cv_t<std::remove_reference_t<Arg>>>;
+
+                return query::is_view_v<_Arg> || (false || ... || std::is_same_v<_Arg, std::remove_cv_t<std::remove_reference_t<Args>>>);
+            }
+
             template <typename Arg>
             void _check_arg() {
                 using _Arg = __impl::remove_sparse_array_t<__impl::argument_helper_t<Self, std::remove_cv_t<std::remove_reference_t<Arg>>>>;
                 using namespace std::string_literals;
 
-                if constexpr (std::negation_v<std::disjunction<
+                if constexpr (query::is_view_v<_Arg>) {
+                    _check_view(static_cast<_Arg *>(nullptr));
+                } else if constexpr (std::negation_v<std::disjunction<
                     std::is_same<_Arg, system_registry>,
                     std::is_same<_Arg, entity_manager>,
                     std::is_same<_Arg, components_registry>,
@@ -438,11 +1048,24 @@ namespace hex {
                 }
             }
 
+            template <typename... Ts>
+            void _check_view(query::view<Ts...> *) {
+                // Excluded components do not need to be registered.
+                ((query::__impl::term<Ts>::excluded ? void() : _check_arg<typename query::__impl::term<Ts>::component>()), ...);
+            }
+
+            template <typename... Ts>
+            void _reg_view(query::view<Ts...> *) {
+                (_reg_arg<typename query::__impl::term<Ts>::component>(), ...);
+            }
+
             template <typename Arg>
             void _reg_arg() {
                 using _Arg = __impl::remove_sparse_array_t<__impl::argument_helper_t<Self, std::remove_cv_t<std::remove_reference_t<Arg>>>>;
 
-                if constexpr (std::negation_v<std::disjunction<
+                if constexpr (query::is_view_v<_Arg>) {
+                    _reg_view(static_cast<_Arg *>(nullptr));
+                } else if constexpr (std::negation_v<std::disjunction<
                     std::is_same<_Arg, system_registry>,
                     std::is_same<_Arg, entity_manager>,
                     std::is_same<_Arg, components_registry>,
@@ -452,23 +1075,81 @@ namespace hex {
                 }
             }
 
+            template <typename Arg>
+            static void _describe_arg(scheduling::access &acc) {
+                using _Arg = __impl::argument_helper_t<Self, std::remove_cv_t<std::remove_reference_t<Arg>>>;
+
+                if constexpr (query::is_view_v<_Arg>)
+                    _Arg::describe(acc);
+                else if constexpr (std::negation_v<std::disjunction<
+                    std::is_same<_Arg, system_registry>,
+                    std::is_same<_Arg, entity_manager>,
+                    std::is_same<_Arg, components_registry>,
+                    std::is_same<_Arg, std::remove_cv_t<std::remove_reference_t<Args>>>...
+                >>) {
+                    std::type_index type = typeid(__impl::remove_sparse_array_t<_Arg>);
+
+                    if (std::is_const_v<std::remove_reference_t<Arg>>)
+                        acc.read(type);
+                    else
+                        acc.write(type);
+                }
+            }
+
+            template <typename ...As, typename Sys>
+            static decltype(auto) _invoke(Sys &sys, system_registry &sr, std::tuple<Args &...> const &run_args) {
+                if constexpr (std::disjunction_v<query::is_view<std::remove_cv_t<std::remove_reference_t<As>>>...>) {
+                    // Views are built first, so the system can be skipped when one of them is empty.
+                    std::tuple<decltype(sr._get_arg<As>(run_args))...> args{sr._get_arg<As>(run_args)...};
+                    using result_t = decltype(std::apply(sys, std::move(args)));
+
+                    if (std::apply([](auto const &...as) { return (false || ... || __impl::is_empty_arg(as)); }, args))
+                        return result_t();
+
+                    return std::apply(sys, std::move(args));
+                } else {
+                    return sys(sr._get_arg<As>(run_args)...);
+                }
+            }
+
             template <bool constness, typename ...As, typename Callable>
-            void _do_register(Callable &&c) {
-                struct { Callable sys; } call = { std::forward<Callable>(c) };
-                if constexpr (constness)
-                    _systems.emplace_back([call = std::move(call)](system_registry &sr, std::tuple<Args &...> const & run_args) {
-                        return call.sys(sr._get_arg<As>(run_args)...);
-                    });
-                else {
-                    _systems.emplace_back([call= std::move(call)] (system_registry &sr, std::tuple<Args &...> const & run_args) mutable {
-                        return call.sys(sr._get_arg<As>(run_args)...);
+            system_handle _do_register(system_options &&opts, Callable &&c) {
+                using result_t = decltype(_invoke<As...>(std::declval<Callable &>(), std::declval<system_registry &>(), std::declval<std::tuple<Args &...> const &>()));
+                scheduling::access access;
+
+                (_describe_arg<As>(access), ...);
+
+                if constexpr (std::is_same_v<result_t, scheduling::task>) {
+                    static_assert((!_is_per_run_arg<As>() && ...), "Coroutine systems cannot take views or run arguments: their parameters are bound once, when the coroutine starts, and would dangle on later ticks.");
+
+                    // The coroutine frame refers to the callable, so it is kept at a stable address.
+                    struct coroutine_state { Callable sys; scheduling::task pending; };
+                    auto state = std::make_shared<coroutine_state>(coroutine_state{std::forward<Callable>(c), {}});
+
+                    return _add_system(std::move(opts), std::move(access), [state = std::move(state)](system_registry &sr, std::tuple<Args &...> const & run_args) {
+                        if (state->pending.done())
+                            state->pending = _invoke<As...>(state->sys, sr, run_args);
+
+                        state->pending.resume(sr._now);
                     });
+                } else {
+                    struct { Callable sys; } call = { std::forward<Callable>(c) };
+
+                    if constexpr (constness)
+                        return _add_system(std::move(opts), std::move(access), [call = std::move(call)](system_registry &sr, std::tuple<Args &...> const & run_args) {
+                            _invoke<As...>(call.sys, sr, run_args);
+                        });
+                    else {
+                        return _add_system(std::move(opts), std::move(access), [call= std::move(call)] (system_registry &sr, std::tuple<Args &...> const & run_args) mutable {
+                            _invoke<As...>(call.sys, sr, run_args);
+                        });
+                    }
                 }
             }
 
             template <typename Callable, typename... As, bool constness>
-            void _do_register(Callable &&c, __impl::sys_args_deduction_helper<void (As...), constness>) {
-                return _do_register<constness, As...>(std::forward<Callable>(c));
+            system_handle _do_register(system_options &&opts, Callable &&c, __impl::sys_args_deduction_helper<void (As...), constness>) {
+                return _do_register<constness, As...>(std::move(opts), std::forward<Callable>(c));
             }
 
             template <typename... As>
@@ -488,7 +1169,17 @@ namespace hex {
         private:
             std::shared_ptr<components_registry> _components;
             std::shared_ptr<entity_manager> _entities;
-            std::vector<caller_t> _systems;
+            std::vector<system_entry> _systems;
+            std::vector<std::size_t> _schedule; /**< Cached execution order, as indices in _systems. */
+            std::vector<std::size_t> _released; /**< Unregistered slots, still in _schedule. */
+            std::vector<std::size_t> _free; /**< Unregistered slots, ready to be reused. */
+            std::size_t _registered = 0; /**< Number of systems ever registered, giving each one its sequence. */
+            std::vector<phase_entry> _phases{phase_entry{scheduling::default_phase}};
+            std::function<scheduling::clock::time_point ()> _now = scheduling::clock::now;
+            std::size_t _tick = 0;
+            scheduling::clock::duration _delta{};
+            std::unordered_set<std::string> _names;
+            std::shared_ptr<tracing::sink> _trace;
     };
 }
 
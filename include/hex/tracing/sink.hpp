@@ -0,0 +1,382 @@
+/**
+** \file sink.hpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 09:12
+** \date Last update: 2026-10-18 09:12
+*/
+
+#ifndef tracing_sink_hpp__
+#define tracing_sink_hpp__
+
+#include <array> // std::array
+#include <atomic> // std::atomic, std::atomic_thread_fence
+#include <chrono> // std::chrono::steady_clock, std::chrono::nanoseconds
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int64_t, std::uint32_t, std::uint64_t
+#include <fstream> // std::ofstream
+#include <memory> // std::unique_ptr, std::make_unique
+#include <mutex> // std::mutex, std::lock_guard
+#include <optional> // std::optional
+#include <ostream> // std::ostream
+#include <string> // std::string
+#include <string_view> // std::string_view
+#include <thread> // std::thread::id, std::this_thread::get_id
+#include <unordered_map> // std::unordered_map
+#include <unordered_set> // std::unordered_set
+#include <vector> // std::vector
+
+namespace hex::tracing {
+    /**
+    ** \brief Kind of a trace record, using the chrome trace phase letters.
+    */
+    enum class phase : char {
+        begin = 'B', /**< Start of a duration event. */
+        end = 'E', /**< End of a duration event. */
+    };
+
+    /**
+    ** \brief Single trace record.
+    **
+    ** Records are trivially copyable so they can be written to a ring_buffer without allocating.
+    ** Both name and category must point to storage that outlives the sink (string literals, typeid names,
+    ** or strings returned by sink::intern).
+    */
+    struct record {
+        char const *name;
+        char const *category;
+        std::int64_t timestamp; /**< Nanoseconds since the sink creation. */
+        phase ph;
+    };
+
+    /**
+    ** \brief Fixed-size, single producer ring buffer of trace records.
+    **
+    ** Each thread writes to its own ring_buffer, so pushing a record never locks. When the buffer is full, the oldest
+    ** records are overwritten.
+    **
+    ** Every slot is a seqlock: its sequence number is odd while the producer writes it, and tells which record it
+    ** holds otherwise. Records are copied field by field through atomics, and the reader keeps a copy only if the
+    ** sequence number did not change meanwhile, so a record being overwritten is skipped rather than torn.
+    */
+    class ring_buffer {
+        /**
+        ** \brief Storage of a single record.
+        */
+        struct slot {
+            std::atomic<std::uint64_t> seq{0}; /**< 2 * position + 1 while written, 2 * position + 2 once written. */
+            std::atomic<char const *> name{nullptr};
+            std::atomic<char const *> category{nullptr};
+            std::atomic<std::int64_t> timestamp{0};
+            std::atomic<phase> ph{phase::begin};
+        };
+
+        public:
+            /**
+            ** \brief Construct a ring buffer.
+            **
+            ** \param [in] capacity Number of records the buffer can hold. Rounded up to a power of two.
+            ** \param [in] tid Thread id to report for these records.
+            */
+            ring_buffer(std::size_t capacity, std::uint32_t tid) : _mask(_round_up(capacity) - 1), _slots(std::make_unique<slot[]>(_mask + 1)), _tid(tid) {}
+
+            ring_buffer(ring_buffer const &) = delete;
+            ring_buffer &operator=(ring_buffer const &) = delete;
+
+            /**
+            ** \brief Append a record, overwriting the oldest one if the buffer is full.
+            **
+            ** \note Must only be called from the thread owning this buffer.
+            */
+            void push(record const &r) noexcept {
+                std::uint64_t head = _head.load(std::memory_order_relaxed);
+                slot &s = _slots[head & _mask];
+
+                s.seq.store(2 * head + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                s.name.store(r.name, std::memory_order_relaxed);
+                s.category.store(r.category, std::memory_order_relaxed);
+                s.timestamp.store(r.timestamp, std::memory_order_relaxed);
+                s.ph.store(r.ph, std::memory_order_relaxed);
+
+                s.seq.store(2 * head + 2, std::memory_order_release);
+                _head.store(head + 1, std::memory_order_release);
+            }
+
+            /**
+            ** \brief Call f with every record written since the last drain, oldest first.
+            **
+            ** Records that were overwritten while draining are skipped.
+            */
+            template <class F>
+            void drain(F &&f) {
+                std::uint64_t head = _head.load(std::memory_order_acquire);
+                std::uint64_t capacity = _mask + 1;
+                std::uint64_t from = head - _tail > capacity ? head - capacity : _tail;
+
+                for (std::uint64_t i = from; i != head; ++i) {
+                    std::optional<record> r = _read(i);
+
+                    if (r)
+                        f(*r);
+                }
+
+                _tail = head;
+            }
+
+            /**
+            ** \brief Thread id reported for this buffer's records.
+            */
+            [[nodiscard]] std::uint32_t tid() const noexcept { return _tid; }
+
+        private:
+            /**
+            ** \brief Copy the record at position i, unless it was overwritten, or is being overwritten.
+            */
+            std::optional<record> _read(std::uint64_t i) const noexcept {
+                slot const &s = _slots[i & _mask];
+                std::uint64_t expected = 2 * i + 2;
+
+                if (s.seq.load(std::memory_order_acquire) != expected)
+                    return std::nullopt;
+
+                record r{
+                    s.name.load(std::memory_order_relaxed),
+                    s.category.load(std::memory_order_relaxed),
+                    s.timestamp.load(std::memory_order_relaxed),
+                    s.ph.load(std::memory_order_relaxed)
+                };
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (s.seq.load(std::memory_order_relaxed) != expected)
+                    return std::nullopt;
+
+                return r;
+            }
+
+            static std::size_t _round_up(std::size_t n) {
+                std::size_t p = 1;
+
+                while (p < n) p <<= 1;
+                return p;
+            }
+
+        private:
+            std::size_t _mask;
+            std::unique_ptr<slot[]> _slots;
+            std::atomic<std::uint64_t> _head{0};
+            std::uint64_t _tail = 0;
+            std::uint32_t _tid;
+    };
+
+    /**
+    ** \brief Collects trace records from any number of threads, and export them as a chrome trace.
+    **
+    ** Every thread recording to a sink gets its own ring_buffer, created the first time it records.
+    ** Afterward, recording never locks: the calling thread finds its buffer through a thread_local cache,
+    ** which holds the buffers of the last few sinks the thread recorded to.
+    **
+    ** The output of write_chrome_trace can be loaded in chrome://tracing, or in the Perfetto UI.
+    **
+    ** A sink cannot be copied or moved, and must outlive every thread recording to it.
+    */
+    class sink {
+        public:
+            using clock = std::chrono::steady_clock;
+
+            /**
+            ** \brief Construct a sink.
+            **
+            ** \param [in] capacity Number of records each thread can buffer between two exports.
+            */
+            explicit sink(std::size_t capacity = 1 << 14) : _id(_next_id()), _capacity(capacity), _epoch(clock::now()) {}
+
+            sink(sink const &) = delete;
+            sink &operator=(sink const &) = delete;
+
+            /**
+            ** \name Recording
+            */
+            /** @{ */
+            /**
+            ** \brief Record the beginning of a duration event on the calling thread.
+            */
+            void begin(char const *name, char const *category) { _record(name, category, phase::begin); }
+
+            /**
+            ** \brief Record the end of a duration event on the calling thread.
+            */
+            void end(char const *name, char const *category) { _record(name, category, phase::end); }
+
+            /**
+            ** \brief Store a copy of a string for the lifetime of the sink.
+            **
+            ** \return A pointer to the stored copy, that can be used as a record name or category.
+            */
+            char const *intern(std::string_view str) {
+                std::lock_guard lock{_mutex};
+
+                return _strings.emplace(str).first->c_str();
+            }
+            /** @} */
+
+            /**
+            ** \name Exporting
+            */
+            /** @{ */
+            /**
+            ** \brief Write every buffered record as a chrome trace JSON document, then discard them.
+            **
+            ** \note Records written while exporting may be missing from the output.
+            */
+            void write_chrome_trace(std::ostream &os) {
+                std::lock_guard lock{_mutex};
+                bool first = true;
+
+                os << "{\"traceEvents\":[";
+                for (auto &buf : _buffers) {
+                    buf->drain([&](record const &r) {
+                        os << (first ? "\n" : ",\n") << "{\"name\":\"";
+                        _escape(os, r.name);
+                        os << "\",\"cat\":\"";
+                        _escape(os, r.category);
+                        os << "\",\"ph\":\"" << static_cast<char>(r.ph)
+                           << "\",\"ts\":" << r.timestamp / 1000 << '.' << _fraction(r.timestamp % 1000)
+                           << ",\"pid\":1,\"tid\":" << buf->tid() << '}';
+                        first = false;
+                    });
+                }
+                os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+            }
+
+            /**
+            ** \brief Write the chrome trace to a file.
+            **
+            ** \return False if the file could not be written.
+            */
+            bool write_chrome_trace(std::string const &path) {
+                std::ofstream out{path};
+
+                if (!out) return false;
+                write_chrome_trace(out);
+
+                return static_cast<bool>(out);
+            }
+            /** @} */
+
+        private:
+            void _record(char const *name, char const *category, phase ph) {
+                auto ts = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _epoch).count();
+
+                _local().push(record{name, category, ts, ph});
+            }
+
+            /**
+            ** \brief Find the buffer of the calling thread.
+            **
+            ** Each thread caches the buffers of the last few sinks it recorded to, so that a thread
+            ** alternating between a handful of sinks only locks the first time it records to each.
+            ** Sink ids are never reused, so an entry of a destroyed sink is never matched again.
+            */
+            ring_buffer &_local() {
+                struct entry { std::uint64_t owner = 0; ring_buffer *buffer = nullptr; };
+                thread_local struct { std::array<entry, local_cache_size> entries; std::size_t next = 0; } cache;
+
+                for (entry const &e : cache.entries)
+                    if (e.owner == _id)
+                        return *e.buffer;
+
+                entry &e = cache.entries[cache.next];
+
+                cache.next = (cache.next + 1) % local_cache_size;
+                e.buffer = &_register_thread();
+                e.owner = _id;
+
+                return *e.buffer;
+            }
+
+            ring_buffer &_register_thread() {
+                std::lock_guard lock{_mutex};
+                auto [it, ok] = _threads.try_emplace(std::this_thread::get_id(), nullptr);
+
+                if (ok) {
+                    _buffers.push_back(std::make_unique<ring_buffer>(_capacity, static_cast<std::uint32_t>(_buffers.size() + 1)));
+                    it->second = _buffers.back().get();
+                }
+
+                return *it->second;
+            }
+
+            static std::uint64_t _next_id() {
+                static std::atomic<std::uint64_t> id{0};
+
+                return ++id;
+            }
+
+            static char const *_fraction(std::int64_t ns) {
+                static thread_local char buf[4];
+
+                buf[0] = static_cast<char>('0' + ns / 100);
+                buf[1] = static_cast<char>('0' + ns / 10 % 10);
+                buf[2] = static_cast<char>('0' + ns % 10);
+                buf[3] = '\0';
+
+                return buf;
+            }
+
+            static void _escape(std::ostream &os, char const *str) {
+                static constexpr char hex_digits[] = "0123456789abcdef";
+
+                for (; str && *str; ++str) {
+                    unsigned char c = static_cast<unsigned char>(*str);
+
+                    if (c == '"' || c == '\\')
+                        os << '\\' << *str;
+                    else if (c < 0x20)
+                        os << "\\u00" << hex_digits[c >> 4] << hex_digits[c & 0xf];
+                    else
+                        os << *str;
+                }
+            }
+
+        private:
+            static constexpr std::size_t local_cache_size = 4; /**< Number of sinks whose buffer each thread caches. */
+
+            std::uint64_t _id; /**< Unique id, used to invalidate thread_local caches. */
+            std::size_t _capacity;
+            clock::time_point _epoch;
+
+            std::mutex _mutex;
+            std::vector<std::unique_ptr<ring_buffer>> _buffers;
+            std::unordered_map<std::thread::id, ring_buffer *> _threads;
+            std::unordered_set<std::string> _strings;
+    };
+
+    /**
+    ** \brief Record a duration event for the lifetime of the scope object.
+    **
+    ** Does nothing if the sink is null, so it can be left in hot paths.
+    */
+    class scope {
+        public:
+            scope(sink *s, char const *name, char const *category) : _sink(s), _name(name), _category(category) {
+                if (_sink) _sink->begin(_name, _category);
+            }
+
+            scope(scope const &) = delete;
+            scope &operator=(scope const &) = delete;
+
+            ~scope() {
+                if (_sink) _sink->end(_name, _category);
+            }
+
+        private:
+            sink *_sink;
+            char const *_name;
+            char const *_category;
+    };
+}
+
+#endif /* end of include guard: tracing_sink_hpp__ */
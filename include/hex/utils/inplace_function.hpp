@@ -0,0 +1,130 @@
+#ifndef hex_utils_inplace_function_hpp_
+#define hex_utils_inplace_function_hpp_
+
+#include <cstddef> // std::byte, std::max_align_t, std::size_t
+#include <functional> // std::invoke
+#include <new> // ::new
+#include <type_traits> // std::decay_t, std::is_invocable_r_v, ...
+#include <utility> // std::forward, std::move
+
+/**
+** \brief Default capacity of a hex::utils::inplace_function, in bytes.
+**
+** Define it before including hex to store larger callbacks.
+*/
+#ifndef HEX_INPLACE_FUNCTION_CAPACITY
+#   define HEX_INPLACE_FUNCTION_CAPACITY 64
+#endif
+
+namespace hex::utils {
+    template <typename Signature, std::size_t Capacity = HEX_INPLACE_FUNCTION_CAPACITY, std::size_t Align = alignof(std::max_align_t)>
+    class inplace_function;
+
+    /**
+    ** \brief Move-only polymorphic function wrapper, that never allocates.
+    **
+    ** Like a std::function, it can hold any callable with a compatible
+    ** signature, but the callable is always stored in a buffer of Capacity
+    ** bytes inside the wrapper. Holding a callable that does not fit is a
+    ** compile-time error.
+    **
+    ** \tparam R Return type.
+    ** \tparam Args Argument types.
+    ** \tparam Capacity Size of the buffer.
+    ** \tparam Align Alignment of the buffer.
+    */
+    template <typename R, typename... Args, std::size_t Capacity, std::size_t Align>
+    class inplace_function<R(Args...), Capacity, Align> {
+        /**
+        ** \brief Operations on the held callable.
+        */
+        struct vtable {
+            R (*invoke)(void *, Args &&...);
+            void (*relocate)(void *, void *) noexcept; /**< Move construct into the first buffer, and destroy the second. */
+            void (*destroy)(void *) noexcept;
+        };
+
+        template <typename F>
+        static constexpr vtable _vtable_for{
+            [](void *f, Args &&... args) -> R {
+                return std::invoke(*static_cast<F *>(f), std::forward<Args>(args)...);
+            },
+            [](void *dst, void *src) noexcept {
+                ::new (dst) F(std::move(*static_cast<F *>(src)));
+                static_cast<F *>(src)->~F();
+            },
+            [](void *f) noexcept {
+                static_cast<F *>(f)->~F();
+            }
+        };
+
+        public:
+            inplace_function() noexcept = default;
+
+            template <typename Callable>
+                requires (!std::is_same_v<std::remove_cvref_t<Callable>, inplace_function>
+                       && std::is_invocable_r_v<R, std::decay_t<Callable> &, Args...>)
+            inplace_function(Callable &&c) {
+                using F = std::decay_t<Callable>;
+
+                static_assert(sizeof(F) <= Capacity, "Callable is too large for this inplace_function: capture less, or increase its capacity.");
+                static_assert(alignof(F) <= Align, "Callable is over-aligned for this inplace_function.");
+                static_assert(std::is_nothrow_move_constructible_v<F>, "Callable stored in an inplace_function must be nothrow movable.");
+
+                ::new (static_cast<void *>(_storage)) F(std::forward<Callable>(c));
+                _vt = &_vtable_for<F>;
+            }
+
+            inplace_function(inplace_function const &) = delete;
+            inplace_function &operator=(inplace_function const &) = delete;
+
+            inplace_function(inplace_function &&other) noexcept : _vt(other._vt) {
+                if (_vt) {
+                    _vt->relocate(_storage, other._storage);
+                    other._vt = nullptr;
+                }
+            }
+
+            inplace_function &operator=(inplace_function &&other) noexcept {
+                if (this != &other) {
+                    reset();
+
+                    if (other._vt) {
+                        other._vt->relocate(_storage, other._storage);
+                        _vt = std::exchange(other._vt, nullptr);
+                    }
+                }
+
+                return *this;
+            }
+
+            ~inplace_function() { reset(); }
+
+            /**
+            ** \brief destroy the held callable, if any.
+            */
+            void reset() noexcept {
+                if (_vt) {
+                    _vt->destroy(_storage);
+                    _vt = nullptr;
+                }
+            }
+
+            explicit operator bool() const noexcept { return _vt != nullptr; }
+
+            /**
+            ** \brief call the held callable.
+            **
+            ** \pre The wrapper must not be empty.
+            */
+            R operator()(Args... args) const {
+                return _vt->invoke(_storage, std::forward<Args>(args)...);
+            }
+
+        private:
+            alignas(Align) mutable std::byte _storage[Capacity];
+            vtable const *_vt = nullptr;
+    };
+}
+
+#endif /* end of include guard: hex_utils_inplace_function_hpp_ */
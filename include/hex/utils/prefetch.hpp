@@ -0,0 +1,20 @@
+#ifndef hex_utils_prefetch_hpp_
+#define hex_utils_prefetch_hpp_
+
+/**
+** \brief Hint the CPU to bring the cache line holding addr into the cache, for reading.
+**
+** Expands to nothing on compilers without a prefetch intrinsic. Defining HEX_NO_PREFETCH disables it too.
+*/
+#if defined(HEX_NO_PREFETCH)
+#   define HEX_PREFETCH(addr) ((void)0)
+#elif defined(__GNUC__) || defined(__clang__)
+#   define HEX_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   include <xmmintrin.h>
+#   define HEX_PREFETCH(addr) _mm_prefetch(reinterpret_cast<char const *>(addr), _MM_HINT_T0)
+#else
+#   define HEX_PREFETCH(addr) ((void)0)
+#endif
+
+#endif /* end of include guard: hex_utils_prefetch_hpp_ */
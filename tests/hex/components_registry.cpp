@@ -10,6 +10,7 @@
 
 #include <hex/components_registry.hpp>
 #include <hex/exceptions/already_registered.hpp>
+#include <hex/query/persistent.hpp>
 
 template <typename T, size_t Id>
 struct Component {
@@ -444,3 +445,66 @@ Test(HexComponentRegistry, erase_at_non_existing_entity, .disabled = false) {
     cr_assert_eq(sa2.at(4), std::nullopt);
     cr_assert_eq(sa2.at(5), std::optional{comp2});
 }
+
+Test(HexComponentRegistry, persistent_query_is_filled_on_registration, .disabled = false) {
+    hex::components_registry cr;
+
+    cr.register_type<Component<int, 0>>();
+    cr.register_type<Component<int, 1>>();
+
+    for (size_t i = 0; i < 10; ++i) {
+        cr.insert_at(i, Component<int, 0>{static_cast<int>(i)});
+
+        if (i % 2)
+            cr.insert_at(i, Component<int, 1>{0});
+    }
+
+    auto &q = cr.register_query<Component<int, 0>, Component<int, 1> const>();
+    auto &excl = cr.register_query<Component<int, 0> const, hex::query::without<Component<int, 1>>>();
+
+    cr_assert_eq(&q, &(cr.register_query<Component<int, 0>, Component<int, 1> const>()));
+    cr_assert_eq(q.size(), 5);
+    cr_assert_eq(excl.size(), 5);
+
+    int sum = 0;
+    q.each(cr, [&](size_t idx, Component<int, 0> &c0, Component<int, 1> const &) {
+        cr_assert(idx % 2);
+        sum += c0.val;
+    });
+    cr_assert_eq(sum, 1 + 3 + 5 + 7 + 9);
+}
+
+Test(HexComponentRegistry, persistent_query_is_updated_incrementally, .disabled = false) {
+    hex::components_registry cr;
+
+    cr.register_type<Component<int, 0>>();
+    cr.register_type<Component<int, 1>>();
+
+    auto &q = cr.register_query<Component<int, 0>, Component<int, 1>>();
+    auto &excl = cr.register_query<Component<int, 0>, hex::query::without<Component<int, 1>>>();
+
+    cr.insert_at(3, Component<int, 0>{3});
+    cr_assert(q.empty());
+    cr_assert(excl.contains(3));
+
+    cr.emplace_at<Component<int, 1>>(3, 3);
+    cr_assert(q.contains(3));
+    cr_assert_not(excl.contains(3));
+
+    cr.insert_at(8, Component<int, 0>{8});
+    cr.insert_at(8, Component<int, 1>{8});
+    cr_assert_eq(q.size(), 2);
+
+    cr.remove_at<Component<int, 1>>(3);
+    cr_assert_not(q.contains(3));
+    cr_assert(excl.contains(3));
+
+    cr.erase_at(8);
+    cr_assert(q.empty());
+    cr_assert_eq(excl.entities(), (std::vector<size_t>{3}));
+
+    cr_assert((cr.unregister_query<Component<int, 0>, Component<int, 1>>()));
+    cr_assert_not((cr.unregister_query<Component<int, 0>, Component<int, 1>>()));
+    cr.insert_at(5, Component<int, 0>{5});
+    cr_assert_eq(excl.size(), 2);
+}
@@ -0,0 +1,131 @@
+/**
+** \file packed_array.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 17:40
+** \date Last update: 2026-10-18 17:40
+*/
+
+#include <criterion/criterion.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <hex/containers/group.hpp>
+#include <hex/containers/packed_array.hpp>
+
+struct ex_component {
+    int x;
+    int y;
+};
+
+TestSuite(HexPackedArray, .description = "Testing Hex's packed_array container.", .disabled = false);
+
+Test(HexPackedArray, IdsStaySorted) {
+    hex::containers::packed_array<int> pa;
+
+    pa.insert_at(7, 70);
+    pa.insert_at(2, 20);
+    pa.insert_at(12, 120);
+    pa.insert_at(5, 50);
+
+    cr_assert_eq(pa.size(), 4);
+    cr_assert_eq(std::vector<size_t>(pa.ids().begin(), pa.ids().end()), (std::vector<size_t>{2, 5, 7, 12}));
+    cr_assert_eq(std::vector<int>(pa.begin(), pa.end()), (std::vector<int>{20, 50, 70, 120}));
+}
+
+Test(HexPackedArray, InsertReplacesExistingElement) {
+    hex::containers::packed_array<ex_component> pa;
+
+    pa.emplace_at(3, 1, 2);
+    auto &c = pa.emplace_at(3, 3, 4);
+
+    cr_assert_eq(pa.size(), 1);
+    cr_assert_eq(c.x, 3);
+    cr_assert_eq(pa.at(3).y, 4);
+}
+
+Test(HexPackedArray, FindAndErase) {
+    hex::containers::packed_array<int> pa;
+
+    for (int i = 0; i < 10; i += 2)
+        pa.insert_at(i, i);
+
+    cr_assert(pa.contains(4));
+    cr_assert_not(pa.contains(5));
+    cr_assert_null(pa.find(5));
+    cr_assert_eq(*pa.find(6), 6);
+
+    pa.erase_at(4);
+    pa.erase_at(5);
+
+    cr_assert_eq(pa.size(), 4);
+    cr_assert_not(pa.contains(4));
+    cr_assert_eq(pa.at(6), 6);
+    cr_assert_throw((void)pa.at(4), std::out_of_range);
+}
+
+Test(HexPackedArray, SortReordersElements) {
+    hex::containers::packed_array<int> pa;
+
+    for (int i = 0; i < 6; ++i)
+        pa.insert_at(i, (i * 7) % 6);
+
+    pa.sort([](int lhs, int rhs) { return lhs > rhs; });
+
+    cr_assert_not(pa.index_ordered());
+    cr_assert_eq(std::vector<int>(pa.begin(), pa.end()), (std::vector<int>{5, 4, 3, 2, 1, 0}));
+    cr_assert_eq(std::vector<size_t>(pa.ids().begin(), pa.ids().end()), (std::vector<size_t>{5, 4, 3, 2, 1, 0}));
+    cr_assert_eq(pa.at(2), 2);
+
+    pa.insert_at(3, 30);
+    pa.insert_at(10, 100);
+    cr_assert_eq(pa.ids().back(), 10);
+    cr_assert_eq(pa.position(4), 1);
+
+    pa.sort();
+
+    cr_assert(pa.index_ordered());
+    cr_assert_eq(std::vector<int>(pa.begin(), pa.end()), (std::vector<int>{0, 1, 2, 30, 4, 5, 100}));
+}
+
+Test(HexPackedArray, GroupPacksSharedIndices) {
+    hex::containers::packed_array<int> a;
+    hex::containers::packed_array<char> b;
+
+    for (int i = 0; i < 20; ++i)
+        a.insert_at(i, i);
+    for (int i = 0; i < 20; i += 3)
+        b.insert_at(i, static_cast<char>('a' + i));
+
+    hex::containers::group g{a, b};
+
+    cr_assert_eq(g.size(), 7);
+
+    auto [as, bs] = g.spans();
+    for (size_t pos = 0; pos < g.size(); ++pos) {
+        cr_assert_eq(a.ids()[pos], b.ids()[pos]);
+        cr_assert_eq(bs[pos], 'a' + as[pos]);
+    }
+
+    b.erase_at(9);
+    b.insert_at(10, 'x');
+
+    std::vector<size_t> indices;
+    g.each([&](size_t idx, int &x, char &c) {
+        cr_assert_eq(x, (int)idx);
+        cr_assert_eq(c, idx == 10 ? 'x' : 'a' + x);
+        indices.push_back(idx);
+    });
+
+    std::sort(indices.begin(), indices.end());
+    cr_assert_eq(indices, (std::vector<size_t>{0, 3, 6, 10, 12, 15, 18}));
+
+    size_t count = 0;
+    for (auto [x, c] : g)
+        count += a.at(x) == x;
+
+    cr_assert_eq(count, 7);
+    cr_assert_eq(a.size(), 20);
+}
@@ -1131,3 +1131,51 @@ Test(HexSparseArray, 21_eraseAt, .disabled = false) {
 
 Test(HexSparseArray, 22_resizeWorksAsExpected, .disabled = true) {}
 Test(HexSparseArray, 23_swapWorksAsExpected, .disabled = true) {}
+
+Test(HexSparseArray, 24_presenceTracksInsertionsAndErasures, .disabled = false) {
+    hex::containers::sparse_array<int> sa;
+
+    sa.insert_at(3, 3);
+    sa.emplace_at(70, 70);
+    sa.insert_at(200, 200);
+    sa.insert_at(10, std::optional<int>{});
+
+    cr_assert_eq(sa.present_count(), 3);
+    cr_assert_eq(sa.next_present(0, sa.size()), 3);
+    cr_assert_eq(sa.next_present(4, sa.size()), 70);
+    cr_assert_eq(sa.next_present(71, sa.size()), 200);
+    cr_assert_eq(sa.next_present(201, sa.size()), sa.size());
+    cr_assert_eq(sa.next_present(4, 50), 50);
+
+    sa.erase_at(70);
+    cr_assert_eq(sa.present_count(), 2);
+    cr_assert_eq(sa.next_present(4, sa.size()), 200);
+
+    sa.resize(100);
+    cr_assert_eq(sa.present_count(), 1);
+    cr_assert_eq(sa.next_present(4, 1000), 1000);
+
+    sa.clear();
+    cr_assert_eq(sa.present_count(), 0);
+}
+
+Test(HexSparseArray, 25_presenceFollowsWholeArrayModifiers, .disabled = false) {
+    hex::containers::sparse_array<int> sa{1, 2, 3};
+    hex::containers::sparse_array<int> other;
+
+    cr_assert_eq(sa.present_count(), 3);
+
+    sa.assign({std::optional<int>{}, std::optional<int>{5}});
+    cr_assert_eq(sa.present_count(), 1);
+    cr_assert_eq(sa.next_present(0, sa.size()), 1);
+
+    // operator[] may be used to write, so its slot is counted as possibly present.
+    sa[0] = 4;
+    cr_assert_eq(sa.next_present(0, sa.size()), 0);
+
+    other.insert_at(130, 1);
+    sa.swap(other);
+    cr_assert_eq(sa.present_count(), 1);
+    cr_assert_eq(sa.next_present(0, sa.size()), 130);
+    cr_assert_eq(other.present_count(), 2);
+}
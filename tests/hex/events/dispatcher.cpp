@@ -0,0 +1,289 @@
+/**
+** \file dispatcher.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 18:50
+** \date Last update: 2026-10-18 18:50
+*/
+
+#include <criterion/criterion.h>
+
+#include <any>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "hex/events/dispatcher.hpp"
+#include "hex/utils/inplace_function.hpp"
+
+using hex::events::callbacks::dispatch_policy;
+namespace policies = hex::events::queues::policies;
+
+struct contact {
+    int a;
+    int b;
+};
+
+TestSuite(HexDispatcher, .description = "Testing Hex's event dispatcher.", .disabled = false);
+
+Test(HexDispatcher, dispatch_bulk_calls_span_callbacks_once, .disabled = false) {
+    hex::events::dispatcher d;
+    std::vector<std::size_t> batches;
+    std::vector<int> singles;
+    std::vector<contact> contacts{{1, 2}, {3, 4}, {5, 6}};
+
+    d.register_callback_for<contact>([&](std::span<contact const> cs) { batches.push_back(cs.size()); }, dispatch_policy::sync);
+    d.register_callback_for<contact>([&](contact const &c) { singles.push_back(c.a); }, dispatch_policy::sync);
+
+    d.dispatch_bulk<contact>(contacts);
+    d.dispatch(contact{7, 8});
+
+    cr_assert_eq(batches, (std::vector<std::size_t>{3, 1}));
+    cr_assert_eq(singles, (std::vector<int>{1, 3, 5, 7}));
+}
+
+Test(HexDispatcher, dispatch_bulk_runs_one_async_task_per_batch, .disabled = false) {
+    hex::events::dispatcher d{std::make_shared<hex::events::thread_pool>(1)};
+    std::vector<std::size_t> batches;
+    std::vector<contact> contacts{{1, 2}, {3, 4}, {5, 6}};
+
+    d.register_callback_for<contact>([&](std::span<contact const> cs) { batches.push_back(cs.size()); }, dispatch_policy::async);
+
+    d.dispatch_bulk<contact>(contacts);
+    d.dispatch_bulk<contact>(std::span<contact const>{contacts}.first(2));
+    d.wait_async();
+
+    cr_assert_eq(batches, (std::vector<std::size_t>{3, 2}));
+}
+
+Test(HexDispatcher, dispatch_bulk_appends_to_queues_in_order, .disabled = false) {
+    hex::events::dispatcher d;
+    std::vector<contact> contacts{{1, 0}, {2, 0}, {3, 0}};
+
+    d.declare(hex::events::kind::polling<contact>);
+    d.dispatch(contact{0, 0});
+    d.dispatch_bulk<contact>(contacts);
+    d.dispatch(contact{4, 0});
+
+    std::vector<int> polled;
+
+    for (contact const &c : d.poll_span<contact>())
+        polled.push_back(c.a);
+
+    cr_assert_eq(polled, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+Test(HexDispatcher, dispatch_bulk_keeps_batches_whole_with_mpsc, .disabled = false) {
+    hex::events::dispatcher d;
+    std::vector<contact> contacts{{1, 0}, {2, 0}, {3, 0}};
+
+    d.declare(hex::events::kind::polling<contact>, policies::mpsc);
+    d.dispatch(contact{0, 0});
+    d.dispatch_bulk<contact>(contacts);
+    d.dispatch(contact{4, 0});
+
+    std::vector<int> polled;
+
+    for (contact const &c : d.poll_span<contact>())
+        polled.push_back(c.a);
+
+    cr_assert_eq(polled, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+Test(HexDispatcher, dispatch_bulk_of_undeclared_event_is_ignored, .disabled = false) {
+    hex::events::dispatcher d;
+    std::vector<contact> contacts{{1, 2}};
+
+    cr_assert_no_throw(d.dispatch_bulk<contact>(contacts), std::exception);
+}
+
+Test(HexDispatcher, event_ids_are_dense_and_stable, .disabled = false) {
+    struct first {};
+    struct second {};
+
+    std::size_t a = hex::events::event_id<first>();
+    std::size_t b = hex::events::event_id<second>();
+
+    cr_assert_neq(a, b);
+    cr_assert_eq(hex::events::event_id<first>(), a);
+    cr_assert_eq(hex::events::event_id<second>(), b);
+}
+
+Test(HexDispatcher, static_dispatcher_handles_its_events, .disabled = false) {
+    hex::events::static_dispatcher<contact, int> d;
+    std::vector<int> received;
+
+    cr_assert(d.declare(hex::events::kind::polling<int>));
+    cr_assert_not(d.declare(hex::events::kind::callback<int>));
+
+    d.register_callback_for<contact>([&](contact const &c) { received.push_back(c.a); }, dispatch_policy::sync);
+
+    d.dispatch(contact{1, 0});
+    d.dispatch(std::any{contact{2, 0}});
+    d.dispatch(3);
+    d.dispatch(std::any{4});
+
+    cr_assert_eq(received, (std::vector<int>{1, 2}));
+    cr_assert_eq(d.poll<int>(), 3);
+    cr_assert_eq(d.poll<int>(), 4);
+    cr_assert_eq(d.poll<int>(), std::nullopt);
+}
+
+Test(HexDispatcher, any_events_of_undeclared_types_are_ignored, .disabled = false) {
+    hex::events::static_dispatcher<contact> s;
+    hex::events::dispatcher d;
+
+    cr_assert_no_throw(s.dispatch(std::any{std::string{"unknown"}}), std::exception);
+    cr_assert_no_throw(d.dispatch(std::any{std::string{"unknown"}}), std::exception);
+}
+
+Test(HexDispatcher, unregister_keeps_registration_order, .disabled = false) {
+    hex::events::dispatcher d;
+    std::string calls;
+
+    auto a = d.register_callback_for<contact>([&](contact const &) { calls += 'A'; }, dispatch_policy::sync);
+    auto b = d.register_callback_for<contact>([&](contact const &) { calls += 'B'; }, dispatch_policy::sync);
+    auto c = d.register_callback_for<contact>([&](contact const &) { calls += 'C'; }, dispatch_policy::sync);
+
+    cr_assert(a && b && c);
+
+    d.unregister_callback(*b);
+    d.dispatch(contact{0, 0});
+    cr_assert_eq(calls, "AC");
+
+    // D reuses the slot of B, which handle is now stale.
+    calls.clear();
+    auto e = d.register_callback_for<contact>([&](contact const &) { calls += 'D'; }, dispatch_policy::sync);
+
+    cr_assert(e.has_value());
+    d.unregister_callback(*b);
+    d.dispatch(contact{0, 0});
+    cr_assert_eq(calls, "ACD");
+
+    calls.clear();
+    d.unregister_callback(*a);
+    d.dispatch(contact{0, 0});
+    cr_assert_eq(calls, "CD");
+}
+
+Test(HexDispatcher, unregister_many_keeps_registration_order, .disabled = false) {
+    hex::events::dispatcher d;
+    std::vector<int> calls;
+    std::vector<hex::events::callbacks::handle> handles;
+
+    for (int i = 0; i < 10; ++i)
+        handles.push_back(*d.register_callback_for<contact>([&calls, i](contact const &) { calls.push_back(i); }, dispatch_policy::sync));
+
+    // Enough unregistered callbacks to have them removed, and their slots reused.
+    for (int i = 0; i < 10; i += 2)
+        d.unregister_callback(handles[i]);
+    d.unregister_callback(handles[3]);
+    d.unregister_callback(handles[3]);
+
+    d.dispatch(contact{0, 0});
+    cr_assert_eq(calls, (std::vector<int>{1, 5, 7, 9}));
+
+    calls.clear();
+    d.register_callback_for<contact>([&calls](contact const &) { calls.push_back(10); }, dispatch_policy::sync);
+    d.unregister_callback(handles[0]);
+    d.dispatch(contact{0, 0});
+    cr_assert_eq(calls, (std::vector<int>{1, 5, 7, 9, 10}));
+}
+
+Test(HexDispatcher, inplace_function_holds_and_moves_callables, .disabled = false) {
+    int calls = 0;
+    hex::utils::inplace_function<int(int)> empty;
+    hex::utils::inplace_function<int(int)> f{[&calls](int x) { ++calls; return x * 2; }};
+
+    cr_assert_not(empty);
+    cr_assert(f);
+    cr_assert_eq(f(21), 42);
+
+    hex::utils::inplace_function<int(int)> g{std::move(f)};
+
+    cr_assert_not(f);
+    cr_assert(g);
+    cr_assert_eq(g(2), 4);
+
+    empty = std::move(g);
+    cr_assert_not(g);
+    cr_assert_eq(empty(3), 6);
+    cr_assert_eq(calls, 3);
+
+    empty.reset();
+    cr_assert_not(empty);
+}
+
+Test(HexDispatcher, inplace_function_destroys_its_callable, .disabled = false) {
+    auto token = std::make_shared<int>(0);
+
+    {
+        hex::utils::inplace_function<void()> f{[token] {}};
+        hex::utils::inplace_function<void()> g{std::move(f)};
+
+        cr_assert_eq(token.use_count(), 2);
+        g = hex::utils::inplace_function<void()>{[] {}};
+        cr_assert_eq(token.use_count(), 1);
+        g = hex::utils::inplace_function<void()>{[token] {}};
+    }
+
+    cr_assert_eq(token.use_count(), 1);
+}
+
+Test(HexDispatcher, trigger_delivers_buffered_events_as_one_batch, .disabled = false) {
+    hex::events::dispatcher d;
+    std::vector<std::size_t> batches;
+    std::vector<int> singles;
+
+    d.register_callback_for<contact>([&](std::span<contact const> cs) { batches.push_back(cs.size()); }, dispatch_policy::trigger);
+    d.register_callback_for<contact>([&](contact const &c) { singles.push_back(c.a); });
+
+    d.dispatch(contact{1, 0});
+    d.dispatch(contact{2, 0});
+    d.dispatch(contact{3, 0});
+    cr_assert(batches.empty());
+    cr_assert(singles.empty());
+
+    d.trigger(hex::events::for_event<contact>);
+    cr_assert_eq(batches, (std::vector<std::size_t>{3}));
+    cr_assert_eq(singles, (std::vector<int>{1, 2, 3}));
+
+    // Nothing was deferred since: the callbacks are not called again.
+    d.trigger(hex::events::for_event<contact>);
+    cr_assert_eq(batches, (std::vector<std::size_t>{3}));
+}
+
+Test(HexDispatcher, events_deferred_during_trigger_wait_for_the_next_one, .disabled = false) {
+    hex::events::dispatcher d;
+    std::vector<int> received;
+
+    d.register_callback_for<contact>([&](contact const &c) {
+        received.push_back(c.a);
+        if (c.a < 3)
+            d.dispatch(contact{c.a + 1, 0});
+    }, dispatch_policy::trigger);
+
+    d.dispatch(contact{0, 0});
+
+    for (int i = 0; i < 5; ++i)
+        d.trigger(hex::events::for_event<contact>);
+
+    cr_assert_eq(received, (std::vector<int>{0, 1, 2, 3}));
+}
+
+Test(HexDispatcher, trigger_async_delivers_on_the_thread_pool, .disabled = false) {
+    hex::events::dispatcher d{std::make_shared<hex::events::thread_pool>(1)};
+    std::vector<std::size_t> batches;
+
+    d.register_callback_for<contact>([&](std::span<contact const> cs) { batches.push_back(cs.size()); }, dispatch_policy::trigger);
+
+    d.dispatch(contact{1, 0});
+    d.dispatch(contact{2, 0});
+    d.trigger_async(hex::events::for_event<contact>);
+    d.trigger_async(hex::events::for_event<contact>);
+    d.wait_async();
+
+    cr_assert_eq(batches, (std::vector<std::size_t>{2}));
+}
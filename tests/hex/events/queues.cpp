@@ -0,0 +1,299 @@
+/**
+** \file queues.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 18:20
+** \date Last update: 2026-10-18 18:20
+*/
+
+#include <criterion/criterion.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "hex/events/dispatcher.hpp"
+
+namespace policies = hex::events::queues::policies;
+
+struct message {
+    int producer;
+    int seq;
+};
+
+TestSuite(HexEventQueues, .description = "Testing Hex's polling event queues.", .disabled = false);
+
+Test(HexEventQueues, mpsc_delivers_every_event_once_in_producer_order, .disabled = false) {
+    constexpr int producers = 4;
+    constexpr int per_producer = 10000;
+
+    hex::events::queues::event_queue q{hex::events::for_event<message>, policies::keep_pending, policies::no_shrink, policies::mpsc};
+    std::vector<std::thread> threads;
+    std::vector<int> next(producers, 0);
+    std::atomic<int> done = 0;
+    int received = 0;
+
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&q, &done, p]{
+            for (int i = 0; i < per_producer; ++i)
+                q.push(message{p, i});
+            ++done;
+        });
+
+    auto consume = [&]{
+        while (auto m = q.poll_one<message>()) {
+            cr_assert_eq(m->seq, next[m->producer]);
+            ++next[m->producer];
+            ++received;
+        }
+
+        q.clear();
+    };
+
+    // Polling while the producers push, so that the inbox is drained concurrently.
+    while (done.load() != producers)
+        consume();
+
+    for (auto &t : threads)
+        t.join();
+    consume();
+
+    cr_assert_eq(received, producers * per_producer);
+
+    for (int p = 0; p < producers; ++p)
+        cr_assert_eq(next[p], per_producer);
+}
+
+static std::vector<int> push_then_poll(hex::events::queues::policies::bounded_t storage, int count) {
+    hex::events::queues::event_queue q{hex::events::for_event<int>, policies::clear_pending, policies::no_shrink, policies::single_producer, storage};
+
+    for (int i = 1; i <= count; ++i)
+        q.push(i);
+
+    return q.poll_all<int>();
+}
+
+Test(HexEventQueues, bounded_drop_newest_keeps_first_events, .disabled = false) {
+    cr_assert_eq(push_then_poll(policies::bounded(3, policies::drop_newest), 5), (std::vector<int>{1, 2, 3}));
+}
+
+Test(HexEventQueues, bounded_drop_oldest_keeps_last_events, .disabled = false) {
+    cr_assert_eq(push_then_poll(policies::bounded(3, policies::drop_oldest), 5), (std::vector<int>{3, 4, 5}));
+}
+
+Test(HexEventQueues, bounded_overwrite_replaces_latest_event, .disabled = false) {
+    cr_assert_eq(push_then_poll(policies::bounded(3, policies::overwrite), 5), (std::vector<int>{1, 2, 5}));
+}
+
+Test(HexEventQueues, bounded_block_waits_for_the_consumer, .disabled = false) {
+    hex::events::queues::ring_buffer<int> ring{2, hex::events::queues::full_policy::block};
+    std::atomic<int> pushed = 0;
+    std::vector<int> received;
+
+    std::thread producer{[&]{
+        for (int i = 0; i < 100; ++i) {
+            ring.push(i);
+            ++pushed;
+        }
+    }};
+
+    while (pushed.load() < 2)
+        std::this_thread::yield();
+
+    // The producer is stuck on the third event until one is polled.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    cr_assert_eq(pushed.load(), 2);
+    cr_assert_eq(ring.size(), 2);
+
+    while (received.size() < 100)
+        if (auto ev = ring.pop())
+            received.push_back(*ev);
+
+    producer.join();
+
+    for (int i = 0; i < 100; ++i)
+        cr_assert_eq(received[i], i);
+}
+
+Test(HexEventQueues, bounded_polls_one_and_clears, .disabled = false) {
+    hex::events::queues::event_queue q{hex::events::for_event<int>, policies::keep_pending, policies::no_shrink, policies::single_producer, policies::bounded(4, policies::drop_newest)};
+
+    q.push(1);
+    q.push(2);
+    q.push(3);
+
+    cr_assert_eq(q.poll_one<int>(), 1);
+    q.clear();
+    cr_assert_eq(q.poll_all<int>(), (std::vector<int>{2, 3}));
+    cr_assert_eq(q.poll_one<int>(), std::nullopt);
+}
+
+Test(HexEventQueues, bounded_rejects_zero_capacity, .disabled = false) {
+    cr_assert_throw((hex::events::queues::ring_buffer<int>{0, hex::events::queues::full_policy::drop_newest}), std::invalid_argument);
+}
+
+Test(HexEventQueues, poll_span_returns_pending_events, .disabled = false) {
+    hex::events::dispatcher d;
+
+    d.declare(hex::events::kind::polling<int>);
+
+    for (int i = 0; i < 5; ++i)
+        d.dispatch(i);
+
+    cr_assert_eq(d.poll<int>(), 0);
+
+    std::span<int> events = d.poll_span<int>();
+
+    cr_assert_eq(std::vector<int>(events.begin(), events.end()), (std::vector<int>{1, 2, 3, 4}));
+
+    // Events pushed meanwhile go to the other buffer, and leave the span untouched.
+    d.dispatch(5);
+    d.dispatch(6);
+    cr_assert_eq(std::vector<int>(events.begin(), events.end()), (std::vector<int>{1, 2, 3, 4}));
+
+    events = d.poll_span<int>();
+    cr_assert_eq(std::vector<int>(events.begin(), events.end()), (std::vector<int>{5, 6}));
+    cr_assert(d.poll_span<int>().empty());
+    cr_assert_eq(d.poll<int>(), std::nullopt);
+}
+
+Test(HexEventQueues, poll_span_reuses_its_buffers, .disabled = false) {
+    hex::events::dispatcher d;
+    std::vector<int const *> buffers;
+
+    d.declare(hex::events::kind::polling<int>);
+
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < 16; ++i)
+            d.dispatch(i);
+
+        buffers.push_back(d.poll_span<int>().data());
+    }
+
+    cr_assert_eq(buffers[0], buffers[2]);
+    cr_assert_eq(buffers[1], buffers[3]);
+}
+
+Test(HexEventQueues, poll_span_on_bounded_queue, .disabled = false) {
+    hex::events::dispatcher d;
+
+    d.declare(hex::events::kind::polling<int>, policies::bounded(2, policies::drop_oldest));
+
+    for (int i = 0; i < 5; ++i)
+        d.dispatch(i);
+
+    std::span<int> events = d.poll_span<int>();
+
+    cr_assert_eq(std::vector<int>(events.begin(), events.end()), (std::vector<int>{3, 4}));
+    cr_assert(d.poll_span<int>().empty());
+}
+
+struct moved {
+    int entity;
+    int x;
+};
+
+static std::vector<int> xs(std::span<moved const> events) {
+    std::vector<int> res;
+
+    for (moved const &m : events)
+        res.push_back(m.x);
+
+    return res;
+}
+
+Test(HexEventQueues, coalesce_keeps_latest_event_per_key, .disabled = false) {
+    hex::events::dispatcher d;
+
+    d.declare(hex::events::kind::polling<moved>, policies::coalesce([](moved const &m) { return m.entity; }));
+
+    d.dispatch(moved{1, 10});
+    d.dispatch(moved{2, 20});
+    d.dispatch(moved{1, 11});
+    d.dispatch(moved{3, 30});
+    d.dispatch(moved{2, 21});
+
+    // Events keep the order in which their key was first pushed.
+    cr_assert_eq(xs(d.poll_span<moved>()), (std::vector<int>{11, 21, 30}));
+    cr_assert(d.poll_span<moved>().empty());
+}
+
+Test(HexEventQueues, coalesce_with_custom_reduce, .disabled = false) {
+    hex::events::dispatcher d;
+
+    d.declare(hex::events::kind::polling<moved>, policies::coalesce(
+        [](moved const &m) { return m.entity; },
+        [](moved &pending, moved const &incoming) { pending.x += incoming.x; }
+    ));
+
+    for (int i = 1; i <= 4; ++i) {
+        d.dispatch(moved{0, i});
+        d.dispatch(moved{1, i * 10});
+    }
+
+    cr_assert_eq(xs(d.poll_span<moved>()), (std::vector<int>{10, 100}));
+}
+
+Test(HexEventQueues, coalesce_key_is_pending_again_after_poll, .disabled = false) {
+    hex::events::queues::event_queue q{hex::events::for_event<moved>, policies::keep_pending, policies::no_shrink, policies::single_producer, policies::coalesce([](moved const &m) { return m.entity; })};
+
+    q.push(moved{1, 10});
+    q.push(moved{2, 20});
+
+    std::optional<moved> first = q.poll_one<moved>();
+
+    cr_assert(first.has_value());
+    cr_assert_eq(first->x, 10);
+
+    // The polled event is never merged into: the key is pushed again, after 2.
+    q.push(moved{1, 11});
+    q.push(moved{2, 21});
+    q.push(moved{1, 12});
+    cr_assert_eq(xs(q.poll_all<moved>()), (std::vector<int>{21, 12}));
+
+    q.clear();
+    q.push(moved{2, 22});
+    q.push(moved{2, 23});
+    cr_assert_eq(xs(q.poll_all<moved>()), (std::vector<int>{23}));
+}
+
+Test(HexEventQueues, coalesce_with_mpsc, .disabled = false) {
+    constexpr int producers = 4;
+    constexpr int per_producer = 10000;
+
+    hex::events::queues::event_queue q{hex::events::for_event<message>, policies::keep_pending, policies::no_shrink, policies::mpsc, policies::coalesce([](message const &m) { return m.producer; })};
+    std::vector<std::thread> threads;
+    std::vector<int> last(producers, -1);
+    std::atomic<int> done = 0;
+
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&q, &done, p]{
+            for (int i = 0; i < per_producer; ++i)
+                q.push(message{p, i});
+            ++done;
+        });
+
+    auto consume = [&]{
+        while (auto m = q.poll_one<message>()) {
+            cr_assert_lt(last[m->producer], m->seq);
+            last[m->producer] = m->seq;
+        }
+
+        q.clear();
+    };
+
+    while (done.load() != producers)
+        consume();
+
+    for (auto &t : threads)
+        t.join();
+    consume();
+
+    // Merged events are lost, but the latest event of each producer is never.
+    for (int p = 0; p < producers; ++p)
+        cr_assert_eq(last[p], per_producer - 1);
+}
@@ -0,0 +1,213 @@
+/**
+** \file thread_pool.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 18:05
+** \date Last update: 2026-10-18 18:05
+*/
+
+#include <criterion/criterion.h>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "hex/events/dispatcher.hpp"
+
+using hex::events::callbacks::dispatch_policy;
+
+struct ping { int value; };
+
+TestSuite(HexThreadPool, .description = "Testing Hex's thread pool, and asynchronous event callbacks.", .disabled = false);
+
+Test(HexThreadPool, runs_every_task_before_destruction, .disabled = false) {
+    std::atomic<int> count = 0;
+
+    {
+        hex::events::thread_pool pool{4};
+
+        cr_assert_eq(pool.size(), 4);
+
+        for (int i = 0; i < 1000; ++i)
+            pool.submit([&]{ ++count; });
+    }
+
+    cr_assert_eq(count.load(), 1000);
+}
+
+Test(HexThreadPool, has_at_least_one_worker, .disabled = false) {
+    hex::events::thread_pool pool{0};
+
+    cr_assert_eq(pool.size(), 1);
+}
+
+Test(HexThreadPool, async_callbacks_run_on_workers, .disabled = false) {
+    hex::events::dispatcher d{std::make_shared<hex::events::thread_pool>(2)};
+    std::atomic<int> sum = 0;
+    std::atomic<bool> on_caller = false;
+    auto caller = std::this_thread::get_id();
+
+    d.register_callback_for<ping>([&](ping const &p) {
+        sum += p.value;
+        if (std::this_thread::get_id() == caller)
+            on_caller = true;
+    }, dispatch_policy::async);
+
+    for (int i = 1; i <= 100; ++i)
+        d.dispatch(ping{i});
+    d.wait_async();
+
+    cr_assert_eq(sum.load(), 5050);
+    cr_assert_not(on_caller.load());
+}
+
+Test(HexThreadPool, wait_async_rethrows_callback_exception, .disabled = false) {
+    hex::events::dispatcher d{std::make_shared<hex::events::thread_pool>(2)};
+    std::atomic<int> calls = 0;
+
+    d.register_callback_for<ping>([&](ping const &p) {
+        ++calls;
+        if (p.value == 3)
+            throw std::runtime_error("failed");
+    }, dispatch_policy::async);
+
+    for (int i = 0; i < 5; ++i)
+        d.dispatch(ping{i});
+
+    cr_assert_throw(d.wait_async(), std::runtime_error);
+    cr_assert_eq(calls.load(), 5);
+    cr_assert_no_throw(d.wait_async(), std::runtime_error);
+}
+
+Test(HexThreadPool, concurrent_dispatches_create_a_single_pool, .disabled = false) {
+    hex::events::dispatcher d;
+    std::atomic<int> count = 0;
+    std::vector<std::thread> producers;
+
+    d.register_callback_for<ping>([&](ping const &) { ++count; }, dispatch_policy::async);
+
+    for (int t = 0; t < 4; ++t)
+        producers.emplace_back([&]{
+            for (int i = 0; i < 250; ++i)
+                d.dispatch(ping{i});
+        });
+
+    for (auto &p : producers)
+        p.join();
+    d.wait_async();
+
+    cr_assert_eq(count.load(), 1000);
+}
+
+Test(HexThreadPool, set_thread_pool_switches_pools, .disabled = false) {
+    auto pool = std::make_shared<hex::events::thread_pool>(1);
+    hex::events::dispatcher d;
+    std::atomic<int> count = 0;
+
+    d.register_callback_for<ping>([&](ping const &) { ++count; }, dispatch_policy::async);
+
+    d.dispatch(ping{0});
+    d.set_thread_pool(pool);
+    d.dispatch(ping{1});
+    d.set_thread_pool(nullptr);
+    d.dispatch(ping{2});
+    d.wait_async();
+
+    cr_assert_eq(count.load(), 3);
+}
+
+Test(HexThreadPool, high_priority_events_start_first, .disabled = false) {
+    struct gate {};
+    struct background { int value; };
+
+    hex::events::dispatcher d{std::make_shared<hex::events::thread_pool>(1)};
+    std::promise<void> open;
+    std::shared_future<void> opened = open.get_future().share();
+    std::vector<int> order;
+
+    d.register_callback_for<gate>([opened](gate const &) { opened.wait(); }, dispatch_policy::async);
+    d.register_callback_for<background>([&](background const &b) { order.push_back(b.value); }, dispatch_policy::async);
+    d.register_callback_for<ping>([&](ping const &p) { order.push_back(p.value); }, dispatch_policy::async);
+    d.set_priority_for<background>(hex::events::priority::low);
+    d.set_priority_for<ping>(hex::events::priority::high);
+
+    // The only worker is busy until the gate opens: every later event waits in its lane.
+    d.dispatch(gate{});
+
+    for (int i = 0; i < 3; ++i)
+        d.dispatch(background{i});
+    for (int i = 10; i < 13; ++i)
+        d.dispatch(ping{i});
+
+    open.set_value();
+    d.wait_async();
+
+    cr_assert_eq(order, (std::vector<int>{10, 11, 12, 0, 1, 2}));
+}
+
+Test(HexThreadPool, async_deliveries_of_a_type_run_in_dispatch_order, .disabled = false) {
+    constexpr int events = 2000;
+
+    hex::events::dispatcher d{std::make_shared<hex::events::thread_pool>(4)};
+    std::vector<int> order;
+    std::atomic<int> running = 0;
+    std::atomic<bool> overlapped = false;
+    std::atomic<int> others = 0;
+
+    order.reserve(events);
+
+    d.register_callback_for<ping>([&](ping const &p) {
+        if (++running != 1)
+            overlapped = true;
+        // Gives other workers a chance to start the next delivery, if it was not serialized.
+        std::this_thread::yield();
+        order.push_back(p.value);
+        --running;
+    }, dispatch_policy::async);
+    d.register_callback_for<int>([&](int) { ++others; }, dispatch_policy::async);
+
+    for (int i = 0; i < events; ++i) {
+        d.dispatch(ping{i});
+        d.dispatch(i);
+    }
+    d.wait_async();
+
+    cr_assert_not(overlapped.load());
+    cr_assert_eq(others.load(), events);
+    cr_assert_eq(order.size(), static_cast<std::size_t>(events));
+
+    for (int i = 0; i < events; ++i)
+        cr_assert_eq(order[i], i);
+}
+
+Test(HexThreadPool, pool_can_be_released_by_its_own_task, .disabled = false) {
+    auto pool = std::make_shared<hex::events::thread_pool>(2);
+    std::weak_ptr<hex::events::thread_pool> released = pool;
+    hex::events::dispatcher d{pool};
+    std::promise<void> open;
+    std::shared_future<void> opened = open.get_future().share();
+    std::atomic<int> count = 0;
+
+    d.register_callback_for<ping>([&count, opened](ping const &) {
+        opened.wait();
+        ++count;
+    }, dispatch_policy::async);
+
+    for (int i = 0; i < 100; ++i)
+        d.dispatch(ping{i});
+
+    // Pending deliveries now hold the last references to the pool, which is destroyed by one of its workers.
+    pool.reset();
+    d.set_thread_pool(nullptr);
+    open.set_value();
+    d.dispatch(ping{100});
+    d.wait_async();
+
+    while (!released.expired())
+        std::this_thread::yield();
+
+    cr_assert_eq(count.load(), 101);
+}
@@ -0,0 +1,124 @@
+/**
+** \file merge_join.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 17:45
+** \date Last update: 2026-10-18 17:45
+*/
+
+#include <criterion/criterion.h>
+
+#include <csignal>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "hex/hex.hpp"
+
+template <typename T, size_t Id = 0>
+struct component {
+    T t;
+    static const size_t ID = Id;
+};
+
+TestSuite(HexMergeJoin, .description = "Testing Hex's merge_join pseudo-container.", .disabled = false);
+
+Test(HexMergeJoin, YieldsCommonIndices) {
+    hex::packed_array<component<int, 0>> a;
+    hex::packed_array<component<int, 1>> b;
+
+    for (int i = 0; i < 30; i += 2)
+        a.insert_at(i, {i});
+    for (int i = 0; i < 30; i += 3)
+        b.insert_at(i, {i * 10});
+
+    std::vector<size_t> indices;
+    for (auto [idx, x, y] : hex::imerge_join{a, b}) {
+        cr_assert_eq(x.t, (int)idx);
+        cr_assert_eq(y.t, (int)idx * 10);
+        indices.push_back(idx);
+    }
+
+    cr_assert_eq(indices, (std::vector<size_t>{0, 6, 12, 18, 24}));
+}
+
+Test(HexMergeJoin, WritesThroughAndHonorsConst) {
+    hex::packed_array<component<int, 0>> pos;
+    hex::packed_array<component<int, 1>> vel;
+
+    for (int i = 0; i < 10; ++i) {
+        pos.insert_at(i, {i});
+
+        if (i & 1)
+            vel.insert_at(i, {100});
+    }
+
+    for (auto [p, v] : hex::merge_join{pos, std::as_const(vel)}) {
+        static_assert(std::is_const_v<std::remove_reference_t<decltype(v)>>);
+        p.t += v.t;
+    }
+
+    cr_assert_eq(pos.at(2).t, 2);
+    cr_assert_eq(pos.at(3).t, 103);
+    cr_assert_eq(pos.at(9).t, 109);
+}
+
+Test(HexMergeJoin, GallopsOverUnevenSizes) {
+    hex::packed_array<component<int, 0>> big;
+    hex::packed_array<component<int, 1>> small;
+    hex::packed_array<component<int, 2>> empty;
+
+    for (int i = 0; i < 10000; ++i)
+        big.insert_at(i, {i});
+
+    small.insert_at(3, {0});
+    small.insert_at(4097, {0});
+    small.insert_at(9999, {0});
+    small.insert_at(20000, {0});
+
+    std::vector<size_t> indices;
+    for (auto [idx, s, b] : hex::imerge_join{small, big})
+        indices.push_back(b.t);
+
+    cr_assert_eq(indices, (std::vector<size_t>{3, 4097, 9999}));
+    hex::merge_join none{big, empty};
+    cr_assert(none.begin() == none.end());
+
+    for (size_t from : {0, 5, 4000})
+        for (size_t target : {0, 4, 4097, 9999, 10000})
+            cr_assert_eq(hex::iterators::gallop(big.ids().data(), big.size(), from, target), std::max(from, target));
+}
+
+Test(HexMergeJoin, IsARange) {
+    hex::packed_array<component<int, 0>> a;
+    hex::packed_array<component<int, 1>> b;
+
+    for (int i = 0; i < 20; ++i) {
+        a.insert_at(i, {i});
+        b.insert_at(i, {i});
+    }
+
+    static_assert(std::ranges::input_range<hex::merge_join<decltype(a), decltype(b)>>);
+    static_assert(std::ranges::view<hex::merge_join<decltype(a), decltype(b)>>);
+
+    size_t count = 0;
+    for (auto [x, y] : hex::merge_join{a, b} | std::views::take(5))
+        count += x.t == y.t;
+
+    cr_assert_eq(count, 5);
+}
+
+#ifndef NDEBUG
+Test(HexMergeJoin, RejectsContainersOutOfIndexOrder, .signal = SIGABRT) {
+    hex::packed_array<component<int, 0>> a;
+    hex::packed_array<component<int, 1>> b;
+
+    for (int i = 0; i < 10; ++i) {
+        a.insert_at(i, {-i});
+        b.insert_at(i, {i});
+    }
+
+    a.sort([](auto const &lhs, auto const &rhs) { return lhs.t < rhs.t; });
+    (void)hex::merge_join{a, b};
+}
+#endif
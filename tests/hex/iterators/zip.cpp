@@ -8,6 +8,9 @@
 
 #include <criterion/criterion.h>
 
+#include <ranges>
+#include <vector>
+
 #include "hex/hex.hpp"
 
 template <typename T, size_t Id = 0>
@@ -137,7 +140,9 @@ Test(HexZip, IteratorAreSwappable) {
     auto it = z.begin();
     auto it2 = z.begin();
 
-    auto e = z.end();
+    auto e = z.begin();
+    ++e;
+    ++e;
 
     using std::swap;
     swap(it, e);
@@ -259,7 +264,9 @@ Test(HexZip, IZipIteratorAreSwappable) {
     auto it = z.begin();
     auto it2 = z.begin();
 
-    auto e = z.end();
+    auto e = z.begin();
+    ++e;
+    ++e;
 
     using std::swap;
     swap(it, e);
@@ -267,3 +274,253 @@ Test(HexZip, IZipIteratorAreSwappable) {
     cr_assert_eq(e, it2);
     cr_assert_eq(it, z.end());
 }
+
+Test(HexZip, SkipLongGapsInAnyContainer) {
+    hex::sparse_array<component<int, 0>> s1;
+    hex::sparse_array<component<int, 1>> s2;
+    hex::sparse_array<component<int, 2>> s3;
+
+    for (int i = 0; i < 1000; ++i)
+        s1.insert_at(i, {i});
+
+    for (int i : {3, 500, 998, 999})
+        s2.insert_at(i, {i});
+
+    for (int i : {500, 999, 2000})
+        s3.insert_at(i, {i});
+
+    std::vector<size_t> seen;
+    for (auto &&[i, v1, v2, v3] : hex::izip{s1, s2, s3}) {
+        cr_assert_eq(v1.t, i);
+        cr_assert_eq(v3.t, i);
+        seen.push_back(i);
+    }
+
+    cr_assert_eq(seen, (std::vector<size_t>{500, 999}));
+}
+
+Test(HexZip, SubrangeStartsAtItsFirstIndex) {
+    hex::sparse_array<component<int, 0>> sa;
+
+    for (int i = 0; i < 20; ++i)
+        sa.insert_at(i, {i});
+
+    hex::zip z{sa};
+    auto sub = z.subrange(5, 8);
+    std::vector<int> seen;
+
+    for (auto &&[v] : sub)
+        seen.push_back(v.t);
+
+    cr_assert_eq(seen, (std::vector<int>{5, 6, 7}));
+    cr_assert_eq(z.subrange(15, 100).last_index(), 20);
+    cr_assert_eq(sub.subrange(0, 6).first_index(), 5);
+    cr_assert_eq(sub.subrange(0, 6).last_index(), 6);
+}
+
+Test(HexZip, SplitCoversEveryIndexOnce) {
+    hex::sparse_array<component<int, 0>> s1;
+    hex::sparse_array<component<int, 1>> s2;
+
+    for (int i = 0; i < 100; ++i) {
+        s1.insert_at(i, {i});
+
+        if (!(i % 3))
+            s2.insert_at(i, {i});
+    }
+
+    auto parts = hex::izip{s1, s2}.split(4);
+    std::vector<size_t> seen;
+
+    cr_assert_eq(parts.size(), 4);
+    for (auto &part : parts)
+        for (auto &&[i, v1, v2] : part)
+            seen.push_back(i);
+
+    cr_assert_eq(seen.size(), 34);
+    for (size_t k = 0; k < seen.size(); ++k)
+        cr_assert_eq(seen[k], k * 3);
+
+    cr_assert_eq(hex::zip{s1}.split(1000).size(), 100);
+}
+
+Test(HexZip, ZipIsARangesView) {
+    using zip_t = hex::zip<hex::sparse_array<component<int, 0>>, hex::sparse_array<component<int, 1>> const>;
+
+    static_assert(std::ranges::view<zip_t>);
+    static_assert(std::ranges::input_range<zip_t>);
+    static_assert(std::ranges::view<hex::izip<hex::sparse_array<component<int, 0>>>>);
+}
+
+Test(HexZip, ZipComposesWithStandardViews) {
+    hex::sparse_array<component<int, 0>> s1;
+    hex::sparse_array<component<int, 1>> s2;
+
+    for (int i = 0; i < 20; ++i) {
+        s1.insert_at(i, {i});
+
+        if (i % 2)
+            s2.insert_at(i, {i});
+    }
+
+    std::vector<size_t> seen;
+    auto odd_multiples_of_three = hex::views::izip(s1, s2)
+        | std::views::filter([](auto const &t) { return std::get<0>(t) % 3 == 0; })
+        | std::views::take(2);
+
+    for (auto &&[i, v1, v2] : odd_multiples_of_three) {
+        cr_assert_eq(v2.t, i);
+        seen.push_back(i);
+    }
+
+    cr_assert_eq(seen, (std::vector<size_t>{3, 9}));
+}
+
+Test(HexZip, WithoutSkipsPresentElements) {
+    hex::sparse_array<component<int, 0>> pos;
+    hex::sparse_array<component<int, 1>> frozen;
+
+    for (int i = 0; i < 20; ++i) {
+        pos.insert_at(i, {i});
+
+        if (i >= 5 && i < 15)
+            frozen.insert_at(i, {i});
+    }
+
+    std::vector<size_t> seen;
+    for (auto &&[i, p] : hex::izip{pos, hex::iterators::without(frozen)}) {
+        cr_assert_eq(p.t, i);
+        seen.push_back(i);
+    }
+
+    cr_assert_eq(seen, (std::vector<size_t>{0, 1, 2, 3, 4, 15, 16, 17, 18, 19}));
+}
+
+Test(HexZip, MaybeYieldsNullWithoutSkipping) {
+    hex::sparse_array<component<int, 0>> pos;
+    hex::sparse_array<component<int, 1>> health;
+
+    for (int i = 0; i < 10; ++i)
+        pos.insert_at(i, {i});
+
+    health.insert_at(3, {30});
+
+    size_t count = 0;
+    for (auto &&[p, h] : hex::zip{pos, hex::iterators::maybe(std::as_const(health))}) {
+        static_assert(std::is_same_v<decltype(h), component<int, 1> const *>);
+
+        if (p.t == 3)
+            cr_assert(h && h->t == 30);
+        else
+            cr_assert_null(h);
+        ++count;
+    }
+
+    cr_assert_eq(count, 10);
+}
+
+Test(HexZip, BlocksCoverRunsOfMatchingIndices) {
+    hex::sparse_array<component<int, 0>> pos;
+    hex::sparse_array<component<int, 1>> vel;
+    hex::sparse_array<component<int, 2>> frozen;
+
+    for (int i = 0; i < 30; ++i) {
+        pos.insert_at(i, {i});
+
+        if (i < 10 || i >= 20)
+            vel.insert_at(i, {1});
+    }
+
+    frozen.insert_at(25, {0});
+
+    std::vector<std::pair<size_t, size_t>> runs;
+    for (auto [first, size, spans] : hex::zip{pos, std::as_const(vel), hex::iterators::without(frozen)}.blocks()) {
+        auto [p, v] = spans;
+
+        static_assert(std::is_const_v<typename decltype(v)::element_type>);
+        cr_assert_eq(p.size(), size);
+
+        for (size_t k = 0; k < size; ++k)
+            p[k]->t += (*v[k]).t;
+
+        runs.emplace_back(first, size);
+    }
+
+    cr_assert_eq(runs, (std::vector<std::pair<size_t, size_t>>{{0, 10}, {20, 5}, {26, 4}}));
+    cr_assert_eq(pos[9]->t, 10);
+    cr_assert_eq(pos[15]->t, 15);
+    cr_assert_eq(pos[25]->t, 25);
+    cr_assert_eq(pos[26]->t, 27);
+}
+
+Test(HexZip, PrefetchDoesNotChangeResults) {
+    hex::sparse_array<component<int, 0>> a;
+    hex::sparse_array<component<int, 1>> b;
+    hex::sparse_array<component<int, 2>> frozen;
+
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0)
+            a.insert_at(i, {i});
+        if (i % 2 == 0)
+            b.insert_at(i, {i});
+        if (i % 4 == 0)
+            frozen.insert_at(i, {i});
+    }
+
+    auto collect = [](auto &&z) {
+        std::vector<size_t> v;
+
+        for (auto [idx, x, y] : z)
+            v.push_back(idx);
+        return v;
+    };
+
+    auto plain = collect(hex::izip{a, b, hex::iterators::without(frozen)});
+
+    for (size_t distance : {1, 4, 16, 200})
+        cr_assert_eq(collect(hex::izip{a, b, hex::iterators::without(frozen)}.prefetch(distance)), plain);
+
+    cr_assert_eq(plain, (std::vector<size_t>{6, 18, 30, 42, 54, 66, 78, 90}));
+    cr_assert_eq(collect(hex::izip{a, b, hex::iterators::without(frozen)}.prefetch(4).subrange(20, 60)), (std::vector<size_t>{30, 42, 54}));
+    cr_assert_eq(collect(hex::izip{hex::iterators::without(frozen), b, a}.prefetch(2)), plain);
+
+    auto it = hex::izip{a, b, hex::iterators::without(frozen)}.prefetch(3).begin();
+
+    it.skip(30);
+    cr_assert_eq(it.index(), 42);
+    ++it;
+    cr_assert_eq(it.index(), 54);
+}
+
+Test(HexZip, SparseJoinLedBySmallestContainer, .disabled = false) {
+    hex::sparse_array<component<int, 0>> dense;
+    hex::sparse_array<component<int, 1>> sparse;
+    std::vector<size_t> expected;
+
+    for (int i = 0; i < 100000; ++i)
+        dense.insert_at(i, {i});
+
+    for (size_t i = 997; i < 100000; i += 4999) {
+        sparse.insert_at(i, {static_cast<int>(i)});
+        expected.push_back(i);
+    }
+
+    // A hole in the dense container, at one of the sparse container's indices.
+    dense.erase_at(expected[3]);
+    expected.erase(expected.begin() + 3);
+
+    std::vector<size_t> found;
+
+    for (auto [idx, d, s] : hex::izip{dense, sparse}) {
+        cr_assert_eq(d.t, s.t);
+        found.push_back(idx);
+    }
+
+    cr_assert_eq(found, expected);
+
+    found.clear();
+    for (auto [idx, s, d] : hex::izip{sparse, dense})
+        found.push_back(idx);
+
+    cr_assert_eq(found, expected);
+}
@@ -0,0 +1,111 @@
+/**
+** \file view.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-18 13:52
+** \date Last update: 2026-10-18 13:52
+*/
+
+#include <criterion/criterion.h>
+
+#include <vector>
+
+#include "hex/hex.hpp"
+
+struct position { int x; };
+struct velocity { int vx; };
+struct frozen {};
+
+static hex::components_registry make_registry() {
+    hex::components_registry cr;
+
+    cr.register_type<position>();
+    cr.register_type<velocity>();
+
+    for (int i = 0; i < 10; ++i)
+        cr.insert_at(i, position{i});
+
+    for (int i = 0; i < 20; i += 2)
+        cr.insert_at(i, velocity{1});
+
+    return cr;
+}
+
+TestSuite(HexView, .description = "Testing Hex's typed query views.", .disabled = false);
+
+Test(HexView, iterate_included_components) {
+    auto cr = make_registry();
+    hex::view<position, velocity const> v{cr};
+    std::vector<int> seen;
+
+    cr_assert_eq(v.bound(), 10);
+
+    for (auto [p, vel] : v) {
+        static_assert(!std::is_const_v<std::remove_reference_t<decltype(p)>>);
+        static_assert(std::is_const_v<std::remove_reference_t<decltype(vel)>>);
+        seen.push_back(p.x);
+        p.x += vel.vx;
+    }
+
+    cr_assert_eq(seen, (std::vector<int>{0, 2, 4, 6, 8}));
+    cr_assert_eq(cr.get<position>()[2]->x, 3);
+    cr_assert_eq(cr.get<position>()[3]->x, 3);
+}
+
+Test(HexView, iterate_without_component) {
+    auto cr = make_registry();
+    std::vector<std::size_t> seen;
+
+    hex::view<position const, hex::without<velocity>>{cr}.each([&](std::size_t idx, position const &p) {
+        cr_assert_eq(static_cast<std::size_t>(p.x), idx);
+        seen.push_back(idx);
+    });
+
+    cr_assert_eq(seen, (std::vector<std::size_t>{1, 3, 5, 7, 9}));
+}
+
+Test(HexView, unregistered_excluded_component_excludes_nothing) {
+    auto cr = make_registry();
+    hex::view<position, hex::without<frozen>> v{cr};
+    std::size_t count = 0;
+
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        cr_assert_eq(it.index(), count);
+        ++count;
+    }
+
+    cr_assert_eq(count, 10);
+}
+
+Test(HexView, unregistered_included_component_throws) {
+    auto cr = make_registry();
+
+    cr_assert_throw((hex::view<position, frozen>{cr}), std::out_of_range);
+}
+
+Test(HexView, empty_view) {
+    auto cr = make_registry();
+
+    cr.register_type<frozen>();
+
+    hex::view<position, frozen> v{cr};
+
+    cr_assert_eq(v.bound(), 0);
+    cr_assert(v.begin() == v.end());
+}
+
+Test(HexView, view_without_match_is_empty) {
+    auto cr = make_registry();
+
+    hex::view<velocity, hex::without<position>> v{cr};
+
+    cr_assert_not(v.empty());
+
+    for (int i = 10; i < 20; i += 2)
+        cr.remove_at<velocity>(i);
+
+    hex::view<velocity, hex::without<position>> w{cr};
+
+    cr_assert_neq(w.bound(), 0);
+    cr_assert(w.empty());
+}
@@ -8,7 +8,10 @@
 
 #include <criterion/criterion.h>
 
+#include <memory>
+#include <sstream>
 #include <stdexcept>
+#include <vector>
 
 #include "./helpers/systems/functions.hpp"
 #include "./helpers/systems/functors.hpp"
@@ -18,6 +21,7 @@ namespace fsystems = systems::functions;
 
 #include "hex/components_registry.hpp"
 #include "hex/entity_manager.hpp"
+#include "hex/events/dispatcher.hpp"
 #include "hex/system_registry.hpp"
 
 struct position { int x; int y; };
@@ -174,7 +178,7 @@ Test(HexSystemRegistry, register_and_run_functions, .disabled = false) {
 
 Test(HexSystemRegistry, register_and_run_one_functor, .disabled = false) {
     auto s = make_system_registry();
-    systems::functor_check_called fun;
+    systems::functor_check_called fun{};
 
     s.register_system(fun);
 
@@ -393,3 +397,483 @@ Test(HexSystemRegistry, run_with_arbitrary_args, .disabled = false) {
 
     s.run(a);
 }
+
+Test(HexSystemRegistry, run_with_trace_sink_records_systems, .disabled = false) {
+    auto s = make_system_registry();
+    auto sink = std::make_shared<hex::tracing::sink>();
+    std::ostringstream out;
+
+    s.register_system(fsystems::system_no_args);
+    s.register_system(fsystems::system_check_is_called);
+    s.set_trace_sink(sink);
+
+    s.run();
+    sink->write_chrome_trace(out);
+
+    auto trace = out.str();
+    cr_assert_neq(trace.find("\"name\":\"system_registry::run\",\"cat\":\"systems\",\"ph\":\"B\""), std::string::npos);
+    cr_assert_neq(trace.find("\"name\":\"system #0\",\"cat\":\"system\",\"ph\":\"E\""), std::string::npos);
+    cr_assert_neq(trace.find("\"name\":\"system #1\",\"cat\":\"system\",\"ph\":\"B\""), std::string::npos);
+
+    std::ostringstream drained;
+    sink->write_chrome_trace(drained);
+    cr_assert_eq(drained.str().find("system #0"), std::string::npos);
+}
+
+Test(HexSystemRegistry, trace_sinks_recorded_to_in_turn_keep_their_records, .disabled = false) {
+    std::vector<std::unique_ptr<hex::tracing::sink>> sinks;
+
+    // More sinks than a thread caches, so that buffers are looked up again.
+    for (int i = 0; i < 6; ++i)
+        sinks.push_back(std::make_unique<hex::tracing::sink>());
+
+    for (int round = 0; round < 3; ++round)
+        for (auto &sink : sinks) {
+            hex::tracing::scope scope{sink.get(), "work", "test"};
+        }
+
+    for (auto &sink : sinks) {
+        std::ostringstream out;
+        sink->write_chrome_trace(out);
+
+        auto trace = out.str();
+        std::size_t count = 0;
+
+        for (auto pos = trace.find("\"name\":\"work\""); pos != std::string::npos; pos = trace.find("\"name\":\"work\"", pos + 1))
+            ++count;
+
+        cr_assert_eq(count, 6);
+        cr_assert_eq(trace.find("\"tid\":2"), std::string::npos);
+    }
+}
+
+Test(HexSystemRegistry, schedule_keeps_registration_order_without_constraints, .disabled = false) {
+    auto s = make_system_registry();
+
+    s.register_system(hex::named("a"), fsystems::system_no_args);
+    s.register_system(fsystems::system_no_args);
+    s.register_system(hex::named("c"), fsystems::system_no_args);
+
+    auto order = s.schedule();
+    cr_assert_eq(order.size(), 3);
+    cr_assert_eq(order[0], "a");
+    cr_assert_eq(order[1], "system #1");
+    cr_assert_eq(order[2], "c");
+}
+
+Test(HexSystemRegistry, schedule_keeps_registration_order_with_reused_slots, .disabled = false) {
+    auto s = make_system_registry();
+    std::string calls;
+
+    auto a = s.register_system([&]() { calls += "A"; });
+    s.register_system([&]() { calls += "B"; });
+    s.register_system([&]() { calls += "C"; });
+
+    cr_assert(s.unregister_system(a));
+    s.register_system([&]() { calls += "D"; });
+    s.register_system([&]() { calls += "E"; });
+
+    s.run();
+
+    cr_assert_eq(calls, "BCDE");
+}
+
+Test(HexSystemRegistry, schedule_respects_before_and_after, .disabled = false) {
+    auto s = make_system_registry();
+    std::string calls;
+
+    s.register_system(hex::named("render").after("physics"), [&]() { calls += "r"; });
+    s.register_system(hex::named("physics").after("input"), [&]() { calls += "p"; });
+    s.register_system(hex::named("input").before("render"), [&]() { calls += "i"; });
+
+    s.run();
+
+    cr_assert_eq(calls, "ipr");
+}
+
+Test(HexSystemRegistry, schedule_respects_phases, .disabled = false) {
+    auto s = make_system_registry();
+    std::string calls;
+
+    s.add_phase("update");
+    s.add_phase("render");
+
+    s.register_system(hex::named("draw").in_phase("render"), [&]() { calls += "d"; });
+    s.register_system(hex::named("move").in_phase("update"), [&]() { calls += "m"; });
+    s.register_system([&]() { calls += "i"; });
+    s.register_system(hex::named("late").in_phase("late"), [&]() { calls += "l"; });
+
+    s.run();
+
+    cr_assert_eq(calls, "imdl");
+    cr_assert_not(s.add_phase("update"));
+}
+
+Test(HexSystemRegistry, schedule_cycle_should_throw, .disabled = false) {
+    auto s = make_system_registry();
+    int calls = 0;
+
+    s.register_system(hex::named("a").before("b"), [&]() { ++calls; });
+    s.register_system(hex::named("b").before("c"), [&]() { ++calls; });
+
+    cr_assert_throw(s.register_system(hex::named("c").before("a"), [&]() { ++calls; }), hex::exceptions::schedule_cycle);
+    cr_assert_throw(s.register_system(hex::named("d").in_phase("next").before("a"), [&]() { ++calls; }), hex::exceptions::schedule_cycle);
+
+    s.run();
+
+    cr_assert_eq(calls, 2);
+    cr_assert_eq(s.schedule().size(), 2);
+}
+
+Test(HexSystemRegistry, schedule_duplicate_name_should_throw, .disabled = false) {
+    auto s = make_system_registry();
+
+    s.register_system(hex::named("a"), fsystems::system_no_args);
+
+    cr_assert_throw(s.register_system(hex::named("a"), fsystems::system_no_args), hex::exceptions::already_registered);
+    cr_assert_eq(s.schedule().size(), 1);
+}
+
+Test(HexSystemRegistry, phase_rate_every, .disabled = false) {
+    auto s = make_system_registry();
+    std::string calls;
+
+    s.add_phase("slow", hex::scheduling::rates::every(3));
+    s.add_phase("spread", hex::scheduling::rates::staggered(2));
+
+    s.register_system([&]() { calls += "a"; });
+    s.register_system(hex::named("slow").in_phase("slow"), [&]() { calls += "s"; });
+    s.register_system(hex::named("x").in_phase("spread"), [&]() { calls += "x"; });
+    s.register_system(hex::named("y").in_phase("spread"), [&]() { calls += "y"; });
+
+    for (int i = 0; i < 4; ++i) {
+        s.run();
+        calls += "|";
+    }
+
+    cr_assert_eq(calls, "asx|ay|ax|asy|");
+    cr_assert_eq(s.tick(), 4);
+}
+
+Test(HexSystemRegistry, phase_rate_fixed_step, .disabled = false) {
+    using namespace std::chrono_literals;
+
+    auto s = make_system_registry();
+    auto now = hex::scheduling::clock::time_point{};
+    std::vector<hex::scheduling::clock::duration> deltas;
+
+    s.set_clock([&]() { return now; });
+    s.add_phase("physics", hex::scheduling::rates::fixed_step(10ms, 2));
+    s.register_system(hex::named("step").in_phase("physics"), [&](hex::system_registry<> const &sr) { deltas.push_back(sr.delta()); });
+
+    s.run();
+    cr_assert_eq(deltas.size(), 0);
+
+    now += 25ms;
+    s.run();
+    cr_assert_eq(deltas.size(), 2);
+    cr_assert(deltas[0] == 10ms);
+
+    now += 5ms;
+    s.run();
+    cr_assert_eq(deltas.size(), 3);
+
+    now += 100ms;
+    s.run();
+    cr_assert_eq(deltas.size(), 5);
+
+    now += 1ms;
+    s.run();
+    cr_assert_eq(deltas.size(), 5);
+}
+
+Test(HexSystemRegistry, phase_rate_budget_slices_across_ticks, .disabled = false) {
+    using namespace std::chrono_literals;
+
+    auto s = make_system_registry();
+    auto now = hex::scheduling::clock::time_point{};
+    std::string calls;
+
+    s.set_clock([&]() { return now; });
+    s.set_phase_rate("heavy", hex::scheduling::rates::budget(10ms));
+
+    for (char c : std::string{"abcde"})
+        s.register_system(hex::named(std::string{c}).in_phase("heavy"), [&, c]() { calls += c; now += 6ms; });
+
+    for (int i = 0; i < 4; ++i) {
+        s.run();
+        calls += "|";
+    }
+
+    cr_assert_eq(calls, "ab|cd|e|ab|");
+}
+
+Test(HexSystemRegistry, phase_rate_budget_ignores_earlier_phases, .disabled = false) {
+    using namespace std::chrono_literals;
+
+    auto s = make_system_registry();
+    auto now = hex::scheduling::clock::time_point{};
+    std::string calls;
+
+    s.set_clock([&]() { return now; });
+    s.add_phase("slow");
+    s.add_phase("heavy", hex::scheduling::rates::budget(10ms));
+
+    s.register_system(hex::named("slow").in_phase("slow"), [&]() { now += 50ms; });
+
+    for (char c : std::string{"abcde"})
+        s.register_system(hex::named(std::string{c}).in_phase("heavy"), [&, c]() { calls += c; now += 6ms; });
+
+    for (int i = 0; i < 3; ++i) {
+        s.run();
+        calls += "|";
+    }
+
+    cr_assert_eq(calls, "ab|cd|e|");
+}
+
+Test(HexSystemRegistry, disabled_systems_are_skipped, .disabled = false) {
+    auto s = make_system_registry();
+    std::string calls;
+
+    s.register_system([&]() { calls += "a"; });
+    auto b = s.register_system([&]() { calls += "b"; });
+
+    cr_assert(s.is_enabled(b));
+    cr_assert(s.disable(b));
+    cr_assert_not(s.is_enabled(b));
+    s.run();
+
+    cr_assert(s.enable(b));
+    s.run();
+
+    cr_assert_eq(calls, "aab");
+    cr_assert_eq(s.schedule().size(), 2);
+}
+
+Test(HexSystemRegistry, unregister_system, .disabled = false) {
+    auto s = make_system_registry();
+    std::string calls;
+
+    s.register_system(hex::named("a").before("b"), [&]() { calls += "a"; });
+    auto b = s.register_system(hex::named("b"), [&]() { calls += "b"; });
+    s.register_system(hex::named("c").before("a"), [&]() { calls += "c"; });
+
+    cr_assert(s.unregister_system(b));
+    cr_assert_not(s.contains(b));
+    cr_assert_not(s.unregister_system(b));
+    cr_assert_not(s.enable(b));
+    s.run();
+
+    auto d = s.register_system(hex::named("b"), [&]() { calls += "d"; });
+    cr_assert(s.contains(d));
+    cr_assert_not(s.contains(b));
+    cr_assert(d != b);
+    s.run();
+
+    cr_assert_eq(calls, "cacad");
+    cr_assert_eq(s.schedule().size(), 3);
+}
+
+Test(HexSystemRegistry, view_parameter, .disabled = false) {
+    auto s = make_system_registry();
+    int moved = 0;
+    int still = 0;
+
+    s.register_system([&](hex::query::view<position, velocity const> v) {
+        for (auto [p, vel] : v) {
+            static_assert(std::is_const_v<std::remove_reference_t<decltype(vel)>>);
+            p.x += vel.vx;
+            ++moved;
+        }
+    });
+    s.register_system([&](hex::query::view<position const, hex::query::without<velocity>> v) {
+        for (auto [p] : v) {
+            cr_assert_eq(p.x, 6);
+            ++still;
+        }
+    });
+
+    s.run();
+
+    cr_assert_eq(moved, 5);
+    cr_assert_eq(still, 5);
+}
+
+Test(HexSystemRegistry, view_parameter_empty_skips_system, .disabled = false) {
+    struct frozen {};
+
+    auto s = make_system_registry();
+    bool called = false;
+
+    s.register_system(hex::auto_register, [&](hex::query::view<frozen> v) { called = true; });
+    s.run();
+
+    cr_assert_not(called);
+}
+
+Test(HexSystemRegistry, view_parameter_without_match_skips_system, .disabled = false) {
+    auto s = make_system_registry();
+    bool called = false;
+
+    s.register_system([](hex::containers::sparse_array<velocity> &velocities) {
+        for (std::size_t i = 0; i < 5; ++i)
+            velocities.erase_at(i);
+    });
+    s.register_system([&](hex::query::view<position const, velocity const> v) {
+        cr_assert_neq(v.bound(), 0);
+        called = true;
+    });
+    s.run();
+
+    cr_assert_not(called);
+}
+
+Test(HexSystemRegistry, system_access_is_recorded, .disabled = false) {
+    auto s = make_system_registry();
+
+    auto a = s.register_system([](hex::query::view<position, velocity const>) {});
+    auto b = s.register_system([](hex::containers::sparse_array<velocity> const &) {});
+    auto c = s.register_system([](hex::containers::sparse_array<velocity> &, hex::entity_manager &) {});
+
+    cr_assert_eq(s.access(a).writes.size(), 1);
+    cr_assert(s.access(a).writes[0] == typeid(position));
+    cr_assert_eq(s.access(a).reads.size(), 1);
+    cr_assert(s.access(a).reads[0] == typeid(velocity));
+    cr_assert_eq(s.access(c).writes.size(), 1);
+
+    cr_assert_not(s.access(a).conflicts_with(s.access(b)));
+    cr_assert(s.access(a).conflicts_with(s.access(c)));
+    cr_assert(s.access(c).conflicts_with(s.access(b)));
+
+    s.unregister_system(a);
+    cr_assert_throw((void)s.access(a), std::invalid_argument);
+}
+
+Test(HexSystemRegistry, coroutine_system_resumes_on_next_tick, .disabled = false) {
+    auto s = make_system_registry();
+    std::string calls;
+
+    s.register_system([&](hex::containers::sparse_array<position> &pos) -> hex::scheduling::task {
+        calls += "a";
+        co_await hex::scheduling::next_tick;
+        calls += "b";
+        co_await hex::scheduling::next_tick;
+        calls += std::to_string(pos.size());
+    });
+
+    for (int i = 0; i < 4; ++i) {
+        s.run();
+        calls += "|";
+    }
+
+    cr_assert_eq(calls, "a|b|10|a|");
+}
+
+Test(HexSystemRegistry, coroutine_system_builds_views_after_suspension, .disabled = false) {
+    auto s = make_system_registry();
+    std::vector<std::size_t> counts;
+
+    s.register_system([&](hex::components_registry &cr) -> hex::scheduling::task {
+        for (;;) {
+            std::size_t count = 0;
+
+            hex::query::view<position const, velocity const>{cr}.each([&](std::size_t, auto const &, auto const &) { ++count; });
+            counts.push_back(count);
+            co_await hex::scheduling::next_tick;
+        }
+    });
+    s.register_system([](hex::containers::sparse_array<velocity> &velocities) {
+        for (std::size_t i = 0; i < velocities.size(); ++i)
+            if (velocities[i]) {
+                velocities.erase_at(i);
+                break;
+            }
+    });
+
+    for (int i = 0; i < 3; ++i)
+        s.run();
+
+    cr_assert_eq(counts, (std::vector<std::size_t>{5, 4, 3}));
+}
+
+Test(HexSystemRegistry, coroutine_system_until, .disabled = false) {
+    auto s = make_system_registry();
+    bool ready = false;
+    int done = 0;
+
+    s.register_system([&]() -> hex::scheduling::task {
+        co_await hex::scheduling::until([&]() { return ready; });
+        ++done;
+    });
+
+    s.run();
+    s.run();
+    cr_assert_eq(done, 0);
+
+    ready = true;
+    s.run();
+    cr_assert_eq(done, 1);
+}
+
+Test(HexSystemRegistry, coroutine_system_next_event, .disabled = false) {
+    struct ping { int value; };
+
+    auto s = make_system_registry();
+    hex::events::dispatcher d;
+    int received = 0;
+
+    d.declare(hex::events::kind::polling<ping>);
+    s.register_system([&]() -> hex::scheduling::task {
+        ping p = co_await hex::scheduling::next_event<ping>(d);
+        received = p.value;
+    });
+
+    s.run();
+    cr_assert_eq(received, 0);
+
+    d.dispatch(ping{42});
+    s.run();
+    cr_assert_eq(received, 42);
+}
+
+Test(HexSystemRegistry, coroutine_system_yield_after, .disabled = false) {
+    using namespace std::chrono_literals;
+
+    auto s = make_system_registry();
+    auto now = hex::scheduling::clock::time_point{};
+    std::string calls;
+
+    s.set_clock([&]() { return now; });
+    s.register_system([&]() -> hex::scheduling::task {
+        for (char c : std::string{"abcde"}) {
+            calls += c;
+            now += 3ms;
+            co_await hex::scheduling::yield_after{5ms};
+        }
+    });
+
+    for (int i = 0; i < 3; ++i) {
+        s.run();
+        calls += "|";
+    }
+
+    cr_assert_eq(calls, "ab|cd|e|");
+}
+
+Test(HexSystemRegistry, coroutine_system_exception_restarts, .disabled = false) {
+    auto s = make_system_registry();
+    int started = 0;
+
+    s.register_system([&]() -> hex::scheduling::task {
+        ++started;
+        co_await hex::scheduling::next_tick;
+        throw std::runtime_error("failed");
+    });
+
+    s.run();
+    cr_assert_throw(s.run(), std::runtime_error);
+    s.run();
+
+    cr_assert_eq(started, 2);
+}